@@ -20,62 +20,54 @@
 #include "AutomationManager.h"
 #include "ControlGrisConstants.h"
 
-AutomationManager::AutomationManager() {
+AutomationManager::AutomationManager()
+    : recordingBuffer (DEFAULT_RECORDING_CAPACITY) {
     sourceLink = SOURCE_LINK_INDEPENDENT;
     drawingType = TRAJECTORY_TYPE_DRAWING;
     fieldWidth = MIN_FIELD_WIDTH;
-    activateState = false;
-    isBackAndForth = false;
-    backAndForthDirection = 0;
-    dampeningCycles = 0;
-    dampeningCycleCount = 0;
-    dampeningLastDelta = 0.0;
+    trajectoryManager = nullptr;
+    trajectoryAxis = TrajectoryManager::AXIS_XY;
     source.setX(0.0f);
     source.setY(0.0f);
-    playbackDuration = currentPlaybackDuration = 5.0;
-    currentTrajectoryPoint = Point<float> (fieldWidth / 2, fieldWidth / 2);
     playbackPosition = Point<float> (-1.0f, -1.0f);
-    trajectoryDeltaTime = lastTrajectoryDeltaTime = 0.0;
-    degreeOfDeviationPerCycle = 0.0;
+    trajectoryRevision = 0;
+    recordingStartTime = 0.0;
+    isRecording = false;
 }
 
 AutomationManager::~AutomationManager() {}
 
 void AutomationManager::setFieldWidth(double newFieldWidth) {
-    float factor = newFieldWidth / fieldWidth;
     fieldWidth = newFieldWidth;
-    if (trajectoryPoints.size() > 0) {
-        AffineTransform t = AffineTransform::scale(factor);
-        for (auto &p : trajectoryPoints)
-            p.applyTransform(t);
+}
+
+Point<float> AutomationManager::pixelToNormalized(Point<float> pos) {
+    return Point<float> (pos.x / fieldWidth, 1.0 - pos.y / fieldWidth);
+}
+
+Point<float> AutomationManager::normalizedToPixel(Point<float> pos) {
+    return Point<float> (pos.x * fieldWidth, (1.0 - pos.y) * fieldWidth);
+}
+
+void AutomationManager::setTrajectoryManager(TrajectoryManager* manager, int axis) {
+    trajectoryManager = manager;
+    trajectoryAxis = axis;
+    if (trajectoryManager != nullptr) {
+        trajectoryManager->setView(trajectoryAxis, this);
     }
 }
 
 void AutomationManager::setActivateState(bool state) {
-    activateState = state;
     if (! state) {
         playbackPosition = Point<float> (-1.0f, -1.0f);
-    } else {
-        trajectoryDeltaTime = lastTrajectoryDeltaTime = 0.0;
-        backAndForthDirection = 0;
-        dampeningCycleCount = 0;
-        dampeningLastDelta = 0.0;
-        currentPlaybackDuration = playbackDuration;
-        currentDegreeOfDeviation = 0.0;
-        deviationCycleCount = 0;
+    }
+    if (trajectoryManager != nullptr) {
+        trajectoryManager->setActivateState(trajectoryAxis, state);
     }
 }
 
 bool AutomationManager::getActivateState() {
-    return activateState;
-}
-
-void AutomationManager::setPlaybackDuration(double value) {
-    playbackDuration = value;
-}
-
-double AutomationManager::getPlaybackDuration() {
-    return playbackDuration;
+    return trajectoryManager != nullptr && trajectoryManager->getActivateState(trajectoryAxis);
 }
 
 void AutomationManager::setPlaybackPositionX(float value) {
@@ -94,26 +86,30 @@ Point<float> AutomationManager::getPlaybackPosition() {
     return playbackPosition;
 }
 
-void AutomationManager::setBackAndForth(bool shouldBeOn) {
-    if (shouldBeOn != isBackAndForth) {
-        isBackAndForth = shouldBeOn;
-    }
+void AutomationManager::setRecordingCapacity(int numberOfPoints) {
+    const ScopedLock lock (trajectoryLock);
+    recordingBuffer.setCapacity(numberOfPoints);
+    isRecording = false;
 }
 
-void AutomationManager::setDampeningCycles(int value) {
-    dampeningCycles = value;
-}
-
-void AutomationManager::setDeviationPerCycle(float value) {
-    degreeOfDeviationPerCycle = value;
+int AutomationManager::getRecordingCapacity() {
+    return recordingBuffer.getCapacity();
 }
 
 void AutomationManager::resetRecordingTrajectory(Point<float> currentPosition) {
+    const ScopedLock lock (trajectoryLock);
+    Point<float> position = pixelToNormalized(currentPosition);
     playbackPosition = Point<float> (-1.0f, -1.0f);
-    trajectoryPoints.clear();
-    trajectoryPoints.add(currentPosition);
-    lastRecordingPoint = currentPosition;
-    setSourcePosition(Point<float> (currentPosition.x / fieldWidth, 1.0 - currentPosition.y / fieldWidth));
+    trajectoryPoints.clearQuick();
+    recordingBuffer.clear();
+    recordingBuffer.add(position, 0.0f);
+    isRecording = true;
+    recordingStartTime = Time::getMillisecondCounterHiRes();
+    trajectoryShape = TrajectoryShape();
+    trajectorySpline.clear();
+    trajectoryRevision++;
+    lastRecordingPoint = position;
+    setSourcePosition(position);
 }
 
 Point<float> AutomationManager::smoothRecordingPosition(Point<float> pos) {
@@ -123,139 +119,185 @@ Point<float> AutomationManager::smoothRecordingPosition(Point<float> pos) {
     return smoothed;
 }
 
+float AutomationManager::getRecordingTime() {
+    return (float)((Time::getMillisecondCounterHiRes() - recordingStartTime) * 0.001);
+}
+
 void AutomationManager::addRecordingPoint(Point<float> pos) {
-    trajectoryPoints.add(smoothRecordingPosition(pos));
+    const ScopedLock lock (trajectoryLock);
+    recordingBuffer.add(smoothRecordingPosition(pixelToNormalized(pos)), getRecordingTime());
+}
+
+void AutomationManager::addRecordingLine(Point<float> start, Point<float> end) {
+    const ScopedLock lock (trajectoryLock);
+    int numSteps = (int)jmax(std::abs(end.x - start.x), std::abs(end.y - start.y));
+    if (numSteps < 1) {
+        return;
+    }
+
+    Point<float> increment = (end - start) * (1.0f / numSteps);
+    float startTime = recordingBuffer.getLastTime();
+    float endTime = getRecordingTime();
+    for (int i = 1; i <= numSteps; i++) {
+        recordingBuffer.add(smoothRecordingPosition(pixelToNormalized(start + increment * (float)i)),
+                            startTime + (endTime - startTime) * i / numSteps);
+    }
 }
 
 int AutomationManager::getRecordingTrajectorySize() {
-    return trajectoryPoints.size();
+    if (isRecording) {
+        return recordingBuffer.size();
+    }
+    return trajectorySpline.isValid() ? trajectorySpline.getNumberOfRecordedPoints() : trajectoryPoints.size();
 }
 
 Point<float> AutomationManager::getFirstRecordingPoint() {
-    return trajectoryPoints.getFirst();
+    if (isRecording) {
+        return normalizedToPixel(recordingBuffer.getFirstPoint());
+    }
+    return normalizedToPixel(trajectorySpline.isValid() ? trajectorySpline.getPoint(0) : trajectoryPoints.getFirst());
 }
 
 Point<float> AutomationManager::getLastRecordingPoint() {
-    return trajectoryPoints.getLast();
+    if (isRecording) {
+        return normalizedToPixel(recordingBuffer.getLastPoint());
+    }
+    return normalizedToPixel(trajectorySpline.isValid() ? trajectorySpline.getPoint(trajectorySpline.getNumberOfPoints() - 1)
+                                                        : trajectoryPoints.getLast());
 }
 
-void AutomationManager::createRecordingPath(Path& path) {
-    path.startNewSubPath(trajectoryPoints[0]);
-    for (int i = 1; i < trajectoryPoints.size(); i++) {
-        path.lineTo(trajectoryPoints[i]);
+void AutomationManager::finishRecordingTrajectory() {
+    const ScopedLock lock (trajectoryLock);
+    if (! isRecording) {
+        return;
+    }
+
+    int size = recordingBuffer.size();
+    Array<Point<float>> recordedPoints;
+    Array<float> recordedTimes;
+    recordedPoints.ensureStorageAllocated(size);
+    recordedTimes.ensureStorageAllocated(size);
+    for (int i = 0; i < size; i++) {
+        recordedPoints.add(recordingBuffer.getPoint(i));
+        recordedTimes.add(recordingBuffer.getTime(i));
     }
+    recordingBuffer.clear();
+    isRecording = false;
+
+    // The recording is dropped once simplified, unless it is too short for a spline.
+    trajectorySpline.setPoints(recordedPoints, recordedTimes, kTrajectorySimplificationTolerance);
+    trajectoryPoints.clearQuick();
+    if (! trajectorySpline.isValid()) {
+        trajectoryPoints.addArray(recordedPoints);
+    }
+    trajectoryRevision++;
 }
 
-void AutomationManager::setTrajectoryDeltaTime(double relativeTimeFromPlay) {
-    trajectoryDeltaTime = relativeTimeFromPlay / currentPlaybackDuration;
-    trajectoryDeltaTime = std::fmod(trajectoryDeltaTime, 1.0f);
-    computeCurrentTrajectoryPoint();
+bool AutomationManager::isRecordingTrajectory() {
+    return isRecording;
 }
 
-void AutomationManager::compressTrajectoryXValues(int maxValue) {
-    int offset = 10.0 + kSourceRadius;
-    maxValue -= offset;
-    int size = getRecordingTrajectorySize();
-    float delta = maxValue / (size + 1.0);
-    for (int i = 0; i < size; i++) {
-        trajectoryPoints.data()[i].setX(i * delta + offset);
-    }
+bool AutomationManager::hasTrajectoryPath() {
+    return trajectoryShape.isValid() || getRecordingTrajectorySize() > 1;
 }
 
-void AutomationManager::computeCurrentTrajectoryPoint() {
-    int dampeningCyclesTimes2 = dampeningCycles * 2;
-    double currentScaleMin = 0.0, currentScaleMax = 0.0;
+void AutomationManager::createRecordingPath(Path& path) {
+    if (trajectoryShape.isValid()) {
+        for (int i = 0; i < kNumberOfShapePathPoints; i++) {
+            Point<float> p = normalizedToPixel(trajectoryShape.getPosition(i / (kNumberOfShapePathPoints - 1.0)));
+            if (i == 0)
+                path.startNewSubPath(p);
+            else
+                path.lineTo(p);
+        }
+        return;
+    }
 
-    if (trajectoryPoints.size() > 0) {
-        if (trajectoryDeltaTime < lastTrajectoryDeltaTime) {
-            if (isBackAndForth) {
-                backAndForthDirection = 1 - backAndForthDirection;
-                dampeningCycleCount++;
-                if (dampeningCycleCount >= dampeningCyclesTimes2)
-                    dampeningCycleCount = dampeningCyclesTimes2;
-            }
-            deviationCycleCount++;
+    if (trajectorySpline.isValid()) {
+        path.startNewSubPath(normalizedToPixel(trajectorySpline.getPoint(0)));
+        for (int i = 1; i < trajectorySpline.getNumberOfPoints(); i++) {
+            Point<float> control1, control2;
+            trajectorySpline.getBezierControlPoints(i - 1, control1, control2);
+            path.cubicTo(normalizedToPixel(control1), normalizedToPixel(control2), normalizedToPixel(trajectorySpline.getPoint(i)));
         }
-        lastTrajectoryDeltaTime = trajectoryDeltaTime;
-
-        double trajectoryPhase;
-        if (isBackAndForth && dampeningCycles > 0) {
-            if (trajectoryDeltaTime <= 0.5) {
-                trajectoryPhase = pow(trajectoryDeltaTime * 2.0, 2.0) * 0.5;
-            } else {
-                trajectoryPhase = 1.0 - pow(1.0 - ((trajectoryDeltaTime - 0.5) * 2.0), 2.0) * 0.5;
-            }
-        } else {
-            trajectoryPhase = trajectoryDeltaTime;
+        return;
+    }
+
+    if (isRecording) {
+        path.startNewSubPath(normalizedToPixel(recordingBuffer.getFirstPoint()));
+        for (int i = 1; i < recordingBuffer.size(); i++) {
+            path.lineTo(normalizedToPixel(recordingBuffer.getPoint(i)));
         }
+        return;
+    }
 
-        double delta = trajectoryPhase * trajectoryPoints.size();
+    path.startNewSubPath(normalizedToPixel(trajectoryPoints[0]));
+    for (int i = 1; i < trajectoryPoints.size(); i++) {
+        path.lineTo(normalizedToPixel(trajectoryPoints[i]));
+    }
+}
 
-        if (backAndForthDirection == 1)
-            delta = trajectoryPoints.size() - delta;
+void AutomationManager::getNormalizedTrajectoryPoints(Array<Point<float>>& dest) {
+    const ScopedLock lock (trajectoryLock);
+    dest = trajectoryPoints;
+}
 
-        if (delta + 1 >= trajectoryPoints.size()) {
-            delta = trajectoryPoints.size();
-        } else if (delta < 0) {
-            delta = 0;
-        }
+TrajectoryShape AutomationManager::getTrajectoryShape() {
+    const ScopedLock lock (trajectoryLock);
+    return trajectoryShape;
+}
 
-        if (isBackAndForth && dampeningCycles > 0) {
-            if (dampeningCycleCount < dampeningCyclesTimes2) {
-                double relativeDeltaTime = (dampeningCycleCount + trajectoryDeltaTime) / dampeningCyclesTimes2;
-                currentPlaybackDuration = playbackDuration - (pow(relativeDeltaTime, 2.0) * playbackDuration * 0.25);
-                currentScaleMin = relativeDeltaTime * trajectoryPoints.size() * 0.5;
-                currentScaleMax = trajectoryPoints.size() - currentScaleMin;
-                double currentScale = (currentScaleMax - currentScaleMin) / trajectoryPoints.size();
-                dampeningLastDelta = delta = delta * currentScale + currentScaleMin;
-            } else {
-                delta = dampeningLastDelta;
-            }
-        } else {
-            dampeningLastDelta = delta;
-        }
+TrajectorySpline AutomationManager::getTrajectorySpline() {
+    const ScopedLock lock (trajectoryLock);
+    return trajectorySpline;
+}
 
-        double deltaRatio = static_cast<double> (trajectoryPoints.size() - 1) / trajectoryPoints.size();
-        delta *= deltaRatio;
-        int index = (int)delta;
-        if (index + 1 < trajectoryPoints.size()) {
-            double frac = delta - index;
-            Point<float> p1 = trajectoryPoints[index];
-            Point<float> p2 = trajectoryPoints[index+1];
-            currentTrajectoryPoint = Point<float> ((p1.x + (p2.x - p1.x) * frac), (p1.y + (p2.y - p1.y) * frac));
-        } else {
-            currentTrajectoryPoint = Point<float> (trajectoryPoints.getLast().x, trajectoryPoints.getLast().y);
-        }
+int AutomationManager::getTrajectoryRevision() {
+    return trajectoryRevision;
+}
+
+bool AutomationManager::applyTrajectoryPosition() {
+    Point<float> position;
+    if (trajectoryManager == nullptr || ! trajectoryManager->takePublishedPosition(trajectoryAxis, position)) {
+        return false;
     }
 
-    if (degreeOfDeviationPerCycle != 0) {
-        bool deviationFlag = true;
-        if (isBackAndForth && dampeningCycles > 0) {
-            if (approximatelyEqual(currentScaleMin, currentScaleMax)) {
-                deviationFlag = false;
-            }
-        }
-        if (deviationFlag) {
-            currentDegreeOfDeviation = (deviationCycleCount + trajectoryDeltaTime) * degreeOfDeviationPerCycle;
-            if (currentDegreeOfDeviation >= 360.0f) {
-                currentDegreeOfDeviation -= 360.0f;
-            }
+    setSourcePosition(position);
+    sendTrajectoryPositionChangedEvent();
+    return true;
+}
+
+void AutomationManager::compressTrajectoryXValues(int maxValue) {
+    const ScopedLock lock (trajectoryLock);
+    int offset = 10.0 + kSourceRadius;
+    maxValue -= offset;
+    int size = getRecordingTrajectorySize();
+    float delta = maxValue / (size + 1.0);
+    if (isRecording) {
+        for (int i = 0; i < size; i++) {
+            recordingBuffer.getPoint(i).setX((i * delta + offset) / fieldWidth);
         }
-        AffineTransform t = AffineTransform::rotation(currentDegreeOfDeviation / 360.0f * 2.f * M_PI, (fieldWidth / 2.f), (fieldWidth / 2.f));
-        currentTrajectoryPoint.applyTransform(t);
+        return;
     }
 
-    if (activateState) {
-        setSourcePosition(Point<float> (currentTrajectoryPoint.x / fieldWidth, 1.0 - currentTrajectoryPoint.y / fieldWidth));
-        sendTrajectoryPositionChangedEvent();
+    // A finished drawing only has its knots, placed where their recorded point would be.
+    if (trajectorySpline.isValid()) {
+        for (int i = 0; i < trajectorySpline.getNumberOfPoints(); i++) {
+            trajectorySpline.setPointX(i, (trajectorySpline.getPhase(i) * (size - 1) * delta + offset) / fieldWidth);
+        }
+    } else {
+        for (int i = 0; i < size; i++) {
+            trajectoryPoints.data()[i].setX((i * delta + offset) / fieldWidth);
+        }
     }
+    trajectoryRevision++;
 }
 
 Point<float> AutomationManager::getCurrentTrajectoryPoint() {
-    if (activateState) {
-        return currentTrajectoryPoint;
+    if (getActivateState()) {
+        return normalizedToPixel(trajectoryManager->getPublishedPosition(trajectoryAxis));
     } else {
-        return Point<float> (getSourcePosition().x * fieldWidth, (1.0 - getSourcePosition().y) * fieldWidth);
+        return normalizedToPixel(getSourcePosition());
     }
 }
 
@@ -279,7 +321,7 @@ void AutomationManager::setSourceAndPlaybackPosition(Point<float> pos) {
 }
 
 void AutomationManager::sendTrajectoryPositionChangedEvent() {
-    if (activateState || drawingType == TRAJECTORY_TYPE_REALTIME || drawingType == TRAJECTORY_TYPE_ALT_REALTIME) {
+    if (getActivateState() || drawingType == TRAJECTORY_TYPE_REALTIME || drawingType == TRAJECTORY_TYPE_ALT_REALTIME) {
         listeners.call([&] (Listener& l) { l.trajectoryPositionChanged(this, source.getPos()); });
     }
 }
@@ -298,217 +340,43 @@ void AutomationManager::fixSourcePosition() {
 }
 
 void AutomationManager::setDrawingType(int type, Point<float> startpos) {
+    const ScopedLock lock (trajectoryLock);
     drawingType = type;
 
     trajectoryPoints.clear();
+    recordingBuffer.clear();
+    isRecording = false;
+    trajectoryShape = TrajectoryShape(drawingType, startpos);
+    trajectorySpline.clear();
+    trajectoryRevision++;
 
-    int offset = fieldWidth / 2;
-    int minlim = 8;
-    int maxlim = fieldWidth - 8;
-
-    Point<float> translated = startpos.translated(-0.5f, -0.5f) * 2.0f;
-    float magnitude = sqrtf(translated.x * translated.x + translated.y * translated.y) * ((fieldWidth - kSourceDiameter) / 2);
-    float angle = atan2f(translated.y, translated.x) - M_PI / 2.0f;
-
-    int fsize = static_cast<int> (fieldWidth);
-    int fsizeOver3 = fsize / 3;
-    int fsizeOver4 = fsize / 4;
-    float x, y;
-    float step = 0, transx = 0, transy = 0, adjustedMagnitude = 0;
-    switch (drawingType) {
-        case TRAJECTORY_TYPE_REALTIME:
-            playbackPosition = Point<float> (-1.0f, -1.0f);
-            break;
-        case TRAJECTORY_TYPE_DRAWING:
-            playbackPosition = Point<float> (-1.0f, -1.0f);
-            break;
-        case TRAJECTORY_TYPE_CIRCLE_CLOCKWISE:
-            for (int i = 0; i < 200; i++) {
-                x = sinf(2.0 * M_PI * i / 199 - angle) * magnitude + offset;
-                x = x < minlim ? minlim : x > maxlim ? maxlim : x;
-                y = -cosf(2.0 * M_PI * i / 199 - angle) * magnitude + offset;
-                y = y < minlim ? minlim : y > maxlim ? maxlim : y;
-                trajectoryPoints.add(Point<float> (x, y));
-            }
-            break;
-        case TRAJECTORY_TYPE_CIRCLE_COUNTER_CLOCKWISE:
-            for (int i = 0; i < 200; i++) {
-                x = -sinf(2.0 * M_PI * i / 199 - angle) * magnitude + offset;
-                x = x < minlim ? minlim : x > maxlim ? maxlim : x;
-                y = -cosf(2.0 * M_PI * i / 199 - angle) * magnitude + offset;
-                y = y < minlim ? minlim : y > maxlim ? maxlim : y;
-                trajectoryPoints.add(Point<float> (x, y));
-            }
-            break;
-        case TRAJECTORY_TYPE_ELLIPSE_CLOCKWISE:
-            for (int i = 0; i < 200; i++) {
-                x = sinf(2.0 * M_PI * i / 199) * magnitude * 0.5;
-                y = -cosf(2.0 * M_PI * i / 199) * magnitude;
-                float mag = sqrtf(x*x + y*y);
-                float ang = atan2f(y, x);
-                x = mag * cosf(ang - angle) + offset;
-                y = mag * sinf(ang - angle) + offset;
-                x = x < minlim ? minlim : x > maxlim ? maxlim : x;
-                y = y < minlim ? minlim : y > maxlim ? maxlim : y;
-                trajectoryPoints.add(Point<float> (x, y));
-            }
-            break;
-        case TRAJECTORY_TYPE_ELLIPSE_COUNTER_CLOCKWISE:
-            for (int i = 0; i < 200; i++) {
-                x = -sinf(2.0 * M_PI * i / 199) * magnitude * 0.5;
-                y = -cosf(2.0 * M_PI * i / 199) * magnitude;
-                float mag = sqrtf(x*x + y*y);
-                float ang = atan2f(y, x);
-                x = mag * cosf(ang - angle) + offset;
-                y = mag * sinf(ang - angle) + offset;
-                x = x < minlim ? minlim : x > maxlim ? maxlim : x;
-                y = y < minlim ? minlim : y > maxlim ? maxlim : y;
-                trajectoryPoints.add(Point<float> (x, y));
-            }
-            break;
-        case TRAJECTORY_TYPE_SPIRAL_CLOCKWISE_OUT_IN:
-            for (int i = 0; i < 300; i++) {
-                x = sinf(2.0 * M_PI * i / 99) * magnitude * (1.0 - i / 300.0);
-                y = -cosf(2.0 * M_PI * i / 99) * magnitude * (1.0 - i / 300.0);
-                float mag = sqrtf(x*x + y*y);
-                float ang = atan2f(y, x);
-                x = mag * cosf(ang - angle) + offset;
-                y = mag * sinf(ang - angle) + offset;
-                x = x < minlim ? minlim : x > maxlim ? maxlim : x;
-                y = y < minlim ? minlim : y > maxlim ? maxlim : y;
-                trajectoryPoints.add(Point<float> (x, y));
-            }
-            break;
-        case TRAJECTORY_TYPE_SPIRAL_COUNTER_CLOCKWISE_OUT_IN:
-            for (int i = 0; i < 300; i++) {
-                x = -sinf(2.0 * M_PI * i / 99) * magnitude * (1.0 - i / 300.0);
-                y = -cosf(2.0 * M_PI * i / 99) * magnitude * (1.0 - i / 300.0);
-                float mag = sqrtf(x*x + y*y);
-                float ang = atan2f(y, x);
-                x = mag * cosf(ang - angle) + offset;
-                y = mag * sinf(ang - angle) + offset;
-                x = x < minlim ? minlim : x > maxlim ? maxlim : x;
-                y = y < minlim ? minlim : y > maxlim ? maxlim : y;
-                trajectoryPoints.add(Point<float> (x, y));
-            }
-            break;
-        case TRAJECTORY_TYPE_SPIRAL_CLOCKWISE_IN_OUT:
-            for (int i = 0; i < 300; i++) {
-                x = sinf(2.0 * M_PI * i / 99 ) * magnitude * (i / 300.0);
-                y = -cosf(2.0 * M_PI * i / 99 ) * magnitude * (i / 300.0);
-                float mag = sqrtf(x*x + y*y);
-                float ang = atan2f(y, x);
-                x = mag * cosf(ang - angle) + offset;
-                y = mag * sinf(ang - angle) + offset;
-                x = x < minlim ? minlim : x > maxlim ? maxlim : x;
-                y = y < minlim ? minlim : y > maxlim ? maxlim : y;
-                trajectoryPoints.add(Point<float> (x, y));
-            }
-            break;
-        case TRAJECTORY_TYPE_SPIRAL_COUNTER_CLOCKWISE_IN_OUT:
-            for (int i = 0; i < 300; i++) {
-                x = -sinf(2.0 * M_PI * i / 99) * magnitude * (i / 300.0);
-                y = -cosf(2.0 * M_PI * i / 99) * magnitude * (i / 300.0);
-                float mag = sqrtf(x*x + y*y);
-                float ang = atan2f(y, x);
-                x = mag * cosf(ang - angle) + offset;
-                y = mag * sinf(ang - angle) + offset;
-                x = x < minlim ? minlim : x > maxlim ? maxlim : x;
-                y = y < minlim ? minlim : y > maxlim ? maxlim : y;
-                trajectoryPoints.add(Point<float> (x, y));
-            }
-            break;
-        case TRAJECTORY_TYPE_SQUARE_CLOCKWISE:
-        case TRAJECTORY_TYPE_SQUARE_COUNTER_CLOCKWISE:
-            step = 1.f / (fieldWidth / 4);
-            transx = translated.x * ((fieldWidth / 2 - kSourceRadius));
-            transy = translated.y * ((fieldWidth / 2 - kSourceRadius));
-            magnitude = sqrtf(transx * transx + transy * transy);
-            adjustedMagnitude = magnitude * M_PI / 2.f;
-            float tmp1, tmp2;
-            for (int i = 0; i < fsize; i++) {
-                if (i < fsizeOver4) {
-                    tmp1 = i * step;
-                    tmp2 = 0.f;
-                } else if (i < (fsizeOver4 * 2)) {
-                    tmp1 = 1.f;
-                    tmp2 = (i - fsizeOver4) * step;
-                } else if (i < (fsizeOver4 * 3)) {
-                    tmp1 = 1.f - ((i - fsizeOver4 * 2) * step);
-                    tmp2 = 1.f;
-                } else {
-                    tmp1 = 0.f;
-                    tmp2 = 1.f - ((i - fsizeOver4 * 3) * step);
-                }
-                if (drawingType == TRAJECTORY_TYPE_SQUARE_CLOCKWISE) {
-                    x = tmp1;
-                    y = tmp2;
-                } else {
-                    x = tmp2;
-                    y = tmp1;
-                }
-                x *= adjustedMagnitude;
-                y *= adjustedMagnitude;
-                x = x + (fieldWidth / 2.f) - (adjustedMagnitude / 2);
-                y = y + (fieldWidth / 2.f) - (adjustedMagnitude / 2);
-                Point<float> p (x, y);
-                AffineTransform t = AffineTransform::rotation(-angle + M_PI / 4.f, (fieldWidth / 2.f), (fieldWidth / 2.f));
-                p.applyTransform(t);
-                p.x = p.x < minlim ? minlim : p.x > maxlim ? maxlim : p.x;
-                p.y = p.y < minlim ? minlim : p.y > maxlim ? maxlim : p.y;
-                trajectoryPoints.add(p);
-            }
-            break;
-        case TRAJECTORY_TYPE_TRIANGLE_CLOCKWISE:
-        case TRAJECTORY_TYPE_TRIANGLE_COUNTER_CLOCKWISE:
-            Point<float> p1 (0.f, -1.f);
-            Point<float> p2, p3;
-            if (drawingType == TRAJECTORY_TYPE_TRIANGLE_CLOCKWISE) {
-                p2 = Point<float> (1.f, 1.f);
-                p3 = Point<float> (-1.f, 1.f);
-            } else { 
-                p2 = Point<float> (-1.f, 1.f);
-                p3 = Point<float> (1.f, 1.f);
-            }
-            step = 1.f / (fieldWidth / 3);
-            transx = translated.x * ((fieldWidth / 2 - kSourceRadius));
-            transy = translated.y * ((fieldWidth / 2 - kSourceRadius));
-            magnitude = sqrtf(transx * transx + transy * transy);
-            for (int i = 0; i < fsize; i++) {
-                if (i < (fsizeOver3)) {
-                    x = (p2.x - p1.x) * i * step + p1.x;
-                    y = (p2.y - p1.y) * i * step + p1.y;
-                } else if (i < (fsizeOver3 * 2)) {
-                    x = (p3.x - p2.x) * (i - fsizeOver3) * step + p2.x;
-                    y = (p3.y - p2.y) * (i - fsizeOver3) * step + p2.y;
-                } else {
-                    x = (p1.x - p3.x) * (i - fsizeOver3 * 2) * step + p3.x;
-                    y = (p1.y - p3.y) * (i - fsizeOver3 * 2) * step + p3.y;
-                }
-                Point<float> p (x * magnitude + (fieldWidth / 2.f), y * magnitude + (fieldWidth / 2.f));
-                p.applyTransform(AffineTransform::rotation(-angle, (fieldWidth / 2.f), (fieldWidth / 2.f)));
-                p.x = p.x < minlim ? minlim : p.x > maxlim ? maxlim : p.x;
-                p.y = p.y < minlim ? minlim : p.y > maxlim ? maxlim : p.y;
-                trajectoryPoints.add(p);
-            }
-            break;
+    if (drawingType == TRAJECTORY_TYPE_REALTIME || drawingType == TRAJECTORY_TYPE_DRAWING) {
+        playbackPosition = Point<float> (-1.0f, -1.0f);
     }
 
-    if (drawingType > TRAJECTORY_TYPE_DRAWING) {
-        setSourcePosition(Point<float> (trajectoryPoints[0].x / fieldWidth, 1.0 - trajectoryPoints[0].y / fieldWidth));
+    if (trajectoryShape.isValid()) {
+        setSourcePosition(trajectoryShape.getPosition(0.0));
     } else {
         setSourcePosition(Point<float> (0.5f, 0.5f));
     }
 }
 
 void AutomationManager::setDrawingTypeAlt(int type) {
+    const ScopedLock lock (trajectoryLock);
     drawingType = type;
 
     trajectoryPoints.clear();
-
+    recordingBuffer.clear();
+    isRecording = false;
+    trajectoryShape = TrajectoryShape();
+    trajectorySpline.clear();
+    trajectoryRevision++;
+
+    // The lines are laid out in a field of the reference width, like the generated shapes.
+    const float fieldSize = TrajectoryShape::kReferenceFieldWidth;
     float offset = 10.0 + kSourceRadius;
-    float width = fieldWidth - offset;
-    float minPos = 15.0, maxPos = fieldWidth - 20.0;
+    float width = fieldSize - offset;
+    float minPos = 15.0, maxPos = fieldSize - 20.0;
 
     switch (drawingType) {
         case TRAJECTORY_TYPE_ALT_REALTIME:
@@ -521,20 +389,20 @@ void AutomationManager::setDrawingTypeAlt(int type) {
             for (int i = 0; i < 200; i++) {
                 float x = (i / 199.0) * width + offset;
                 float y = (i / 199.0) * (maxPos - minPos) + minPos;
-                trajectoryPoints.add(Point<float> (x, y));
+                trajectoryPoints.add(Point<float> (x / fieldSize, 1.0 - y / fieldSize));
             }
             break;
         case TRAJECTORY_TYPE_ALT_UP_DOWN:
             for (int i = 0; i < 200; i++) {
                 float x = (i / 199.0) * width + offset;
                 float y = (1.0 - i / 199.0) * (maxPos - minPos) + minPos;
-                trajectoryPoints.add(Point<float> (x, y));
+                trajectoryPoints.add(Point<float> (x / fieldSize, 1.0 - y / fieldSize));
             }
             break;
     }
 
     if (drawingType > TRAJECTORY_TYPE_ALT_DRAWING) {
-        setSourcePosition(Point<float> (trajectoryPoints[0].x / fieldWidth, 1.0 - trajectoryPoints[0].y / fieldWidth));
+        setSourcePosition(trajectoryPoints[0]);
     } else {
         setSourcePosition(Point<float> (0.5f, 0.5f));
     }
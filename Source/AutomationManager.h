@@ -21,6 +21,16 @@
 
 #include "../JuceLibraryCode/JuceHeader.h"
 #include "Source.h"
+#include "TrajectoryManager.h"
+#include "TrajectoryShape.h"
+#include "TrajectorySpline.h"
+#include "RecordingBuffer.h"
+
+// Number of points used to draw a generated trajectory in the field.
+static const int kNumberOfShapePathPoints = 200;
+
+// Maximum distance, in normalized coordinates, between a drawn trajectory and its simplification.
+static const float kTrajectorySimplificationTolerance = 0.002f;
 
 class AutomationManager
 {
@@ -30,38 +40,58 @@ public:
 
     void setFieldWidth(double newFieldWidth);
 
+    // The trajectory drawn in this manager is played by trajectoryManager, as the given axis.
+    void setTrajectoryManager(TrajectoryManager* manager, int axis);
+
     void setActivateState(bool state);
     bool getActivateState();
 
-    void setPlaybackDuration(double value);
-    double getPlaybackDuration();
-
     void setPlaybackPositionX(float value);
     void setPlaybackPositionY(float value);
     bool hasValidPlaybackPosition();
     Point<float> getPlaybackPosition();
 
+    // Maximum number of points kept while drawing. Not to be changed while drawing.
+    void setRecordingCapacity(int numberOfPoints);
+    int getRecordingCapacity();
+
+    // A drawing goes in the recording buffer, without allocations, and is handed to
+    // the trajectory by finishRecordingTrajectory().
     void resetRecordingTrajectory(Point<float> currentPosition);
     void addRecordingPoint(Point<float> pos);
+    // Adds the points of a straight line, timed from the last point to now.
+    void addRecordingLine(Point<float> start, Point<float> end);
     int getRecordingTrajectorySize();
     Point<float> getFirstRecordingPoint();
     Point<float> getLastRecordingPoint();
+    // Called when the drawing is done. Copies the recorded points to the trajectory and fits
+    // the spline played and drawn in their place.
+    void finishRecordingTrajectory();
+    // True between resetRecordingTrajectory() and finishRecordingTrajectory().
+    bool isRecordingTrajectory();
     Point<float> getCurrentTrajectoryPoint();
+    bool hasTrajectoryPath();
     void createRecordingPath(Path& path);
-    void setTrajectoryDeltaTime(double relativeTimeFromPlay);
+    // Copies the points of the trajectory when it is neither generated nor a spline.
+    void getNormalizedTrajectoryPoints(Array<Point<float>>& dest);
+    // The generated trajectory, invalid when the trajectory is drawn.
+    TrajectoryShape getTrajectoryShape();
+    // The simplified drawn trajectory, invalid until the recording is finished.
+    TrajectorySpline getTrajectorySpline();
+    // Incremented every time the trajectory points change.
+    int getTrajectoryRevision();
     void compressTrajectoryXValues(int maxValue);
 
+    // Called on the message thread. Returns true if a new position, computed by the
+    // trajectory manager, was applied to the source.
+    bool applyTrajectoryPosition();
+
     void setSourceLink(int value);
     int getSourceLink();
     void setDrawingType(int type, Point<float> startpos);
     int getDrawingType();
     void setDrawingTypeAlt(int type);
 
-    void setBackAndForth(bool shouldBeOn);
-    void setDampeningCycles(int value);
-
-    void setDeviationPerCycle(float value);
-
     Source& getSource();
     void setSourcePosition(Point<float> pos);
     void setSourcePositionX(float x);
@@ -91,32 +121,33 @@ private:
     int             sourceLink;
     int             drawingType;
 
-    bool            isBackAndForth;
-    int             backAndForthDirection;
-
-    int             dampeningCycles;
-    int             dampeningCycleCount;
-    double          dampeningLastDelta;
-
-    bool            activateState;
-    double          playbackDuration;
-    double          currentPlaybackDuration;
+    TrajectoryManager *trajectoryManager;
+    int             trajectoryAxis;
     Point<float>    playbackPosition;
 
     Source source;
 
-    double              trajectoryDeltaTime;
-    double              lastTrajectoryDeltaTime;
+    // In normalized source coordinates (0 to 1, y up). The recording functions take and
+    // return positions in pixels of the field, converted with fieldWidth. A finished
+    // drawing only keeps the knots of trajectorySpline, with their recording times.
     Array<Point<float>> trajectoryPoints;
-    Point<float>        currentTrajectoryPoint;
+    double              recordingStartTime;
+
+    // The drawing in progress, in normalized coordinates and seconds.
+    RecordingBuffer     recordingBuffer;
+    bool                isRecording;
+    TrajectoryShape     trajectoryShape;
+    TrajectorySpline    trajectorySpline;
+    int                 trajectoryRevision;
     Point<float>        lastRecordingPoint;
 
-    float          degreeOfDeviationPerCycle;
-    float          currentDegreeOfDeviation;
-    int            deviationCycleCount;
+    // Protects the trajectory points.
+    CriticalSection     trajectoryLock;
 
-    void computeCurrentTrajectoryPoint();
     Point <float> smoothRecordingPosition(Point<float> pos);
+    float getRecordingTime();
+    Point<float> pixelToNormalized(Point<float> pos);
+    Point<float> normalizedToPixel(Point<float> pos);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AutomationManager)
 };
@@ -22,9 +22,30 @@
 // Global variables.
 //------------------
 const int MIN_FIELD_WIDTH = 300;
-const int MAX_NUMBER_OF_SOURCES = 8;
+// Capacity of the source bank. Only the first numberOfSources sources are active.
+const int MAX_NUMBER_OF_SOURCES = 128;
 const int NUMBER_OF_POSITION_PRESETS = 50;
 
+// Rate, in Hz, of the clock sending source positions to the server.
+const int DEFAULT_OSC_OUTPUT_RATE = 50;
+const int MIN_OSC_OUTPUT_RATE = 50;
+const int MAX_OSC_OUTPUT_RATE = 1000;
+
+// Maximum size, in bytes, of an OSC bundle sent to the server. The default fits in an ethernet MTU.
+const int DEFAULT_OSC_MAX_DATAGRAM_SIZE = 1400;
+const int MIN_OSC_MAX_DATAGRAM_SIZE = 128;
+const int MAX_OSC_MAX_DATAGRAM_SIZE = 65507;
+
+// Interval, in milliseconds, between full refreshes of all sources sent to the server.
+const int DEFAULT_OSC_KEEP_ALIVE_INTERVAL = 1000;
+const int MIN_OSC_KEEP_ALIVE_INTERVAL = 100;
+const int MAX_OSC_KEEP_ALIVE_INTERVAL = 10000;
+
+// Maximum number of points kept while drawing a trajectory. Longer drawings are decimated.
+const int DEFAULT_RECORDING_CAPACITY = 4096;
+const int MIN_RECORDING_CAPACITY = 256;
+const int MAX_RECORDING_CAPACITY = 65536;
+
 // Spatialisation modes.
 //----------------------
 enum SPAT_MODE_ENUM {
@@ -108,18 +129,57 @@ enum TRAJECTORY_TYPE_ALT_ENUM { TRAJECTORY_TYPE_ALT_REALTIME = 1,
 const StringArray TRAJECTORY_TYPE_ALT_TYPES    {String("Realtime"), String("Drawing"), String("Up Down"),
                                                 String("Down Up")};
 
-// Fix position data headers.
-//---------------------------
-const StringArray FIXED_POSITION_DATA_HEADERS { String("ID"),
-                                                String("S1_X"), String("S1_Y"), String("S1_Z"),
-                                                String("S2_X"), String("S2_Y"), String("S2_Z"),
-                                                String("S3_X"), String("S3_Y"), String("S3_Z"),
-                                                String("S4_X"), String("S4_Y"), String("S4_Z"),
-                                                String("S5_X"), String("S5_Y"), String("S5_Z"),
-                                                String("S6_X"), String("S6_Y"), String("S6_Z"),
-                                                String("S7_X"), String("S7_Y"), String("S7_Z"),
-                                                String("S8_X"), String("S8_Y"), String("S8_Z"),
-                                                String("T1_X"), String("T1_Y"), String("T1_Z"),
-                                                String("T2_X"), String("T2_Y"), String("T2_Z")};
+// Trajectories -> Cycle duration unit popup choices.
+//---------------------------------------------------
+enum DURATION_UNIT_ENUM { DURATION_UNIT_SECONDS = 1,
+                          DURATION_UNIT_BEATS,
+                          DURATION_UNIT_BARS
+                        };
+
+// Controller OSC addresses, relative to "/controlgris/<plugin id>".
+//------------------------------------------------------------------
+enum OSC_ADDRESS_ENUM { OSC_ADDRESS_TRAJ_X = 0,
+                        OSC_ADDRESS_TRAJ_XYZ_1,
+                        OSC_ADDRESS_TRAJ_Y,
+                        OSC_ADDRESS_TRAJ_XYZ_2,
+                        OSC_ADDRESS_TRAJ_Z,
+                        OSC_ADDRESS_TRAJ_XYZ_3,
+                        OSC_ADDRESS_TRAJ_XY,
+                        OSC_ADDRESS_TRAJ_XYZ,
+                        OSC_ADDRESS_AZISPAN,
+                        OSC_ADDRESS_ELESPAN,
+                        OSC_ADDRESS_SOURCE_LINK,
+                        OSC_ADDRESS_SOURCE_LINK_1,
+                        OSC_ADDRESS_SOURCE_LINK_2,
+                        OSC_ADDRESS_SOURCE_LINK_3,
+                        OSC_ADDRESS_SOURCE_LINK_4,
+                        OSC_ADDRESS_SOURCE_LINK_5,
+                        OSC_ADDRESS_SOURCE_LINK_6,
+                        OSC_ADDRESS_SOURCE_LINK_7,
+                        OSC_ADDRESS_SOURCE_LINK_8,
+                        OSC_ADDRESS_SOURCE_LINK_ALT,
+                        OSC_ADDRESS_SOURCE_LINK_ALT_1,
+                        OSC_ADDRESS_SOURCE_LINK_ALT_2,
+                        OSC_ADDRESS_SOURCE_LINK_ALT_3,
+                        OSC_ADDRESS_SOURCE_LINK_ALT_4,
+                        OSC_ADDRESS_SOURCE_LINK_ALT_5,
+                        OSC_ADDRESS_PRESETS,
+                        OSC_ADDRESS_NUMBER_OF_ADDRESSES
+                      };
+const StringArray OSC_ADDRESS_SUFFIXES    {String("/traj/1/x"), String("/traj/1/xyz/1"),
+                                           String("/traj/1/y"), String("/traj/1/xyz/2"),
+                                           String("/traj/1/z"), String("/traj/1/xyz/3"),
+                                           String("/traj/1/xy"), String("/traj/1/xyz"),
+                                           String("/azispan"), String("/elespan"),
+                                           String("/sourcelink"),
+                                           String("/sourcelink/1/1"), String("/sourcelink/2/1"),
+                                           String("/sourcelink/3/1"), String("/sourcelink/4/1"),
+                                           String("/sourcelink/5/1"), String("/sourcelink/6/1"),
+                                           String("/sourcelink/7/1"), String("/sourcelink/8/1"),
+                                           String("/sourcelinkalt"),
+                                           String("/sourcelinkalt/1/1"), String("/sourcelinkalt/2/1"),
+                                           String("/sourcelinkalt/3/1"), String("/sourcelinkalt/4/1"),
+                                           String("/sourcelinkalt/5/1"),
+                                           String("/presets")};
 
 const String FIXED_POSITION_DATA_TAG ("Fix_Position_Data");
@@ -0,0 +1,258 @@
+/**************************************************************************
+ * Copyright 2018 UdeM - GRIS - Olivier Belanger                          *
+ *                                                                        *
+ * This file is part of ControlGris, a multi-source spatialization plugin *
+ *                                                                        *
+ * ControlGris is free software: you can redistribute it and/or modify    *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * ControlGris is distributed in the hope that it will be useful,         *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with ControlGris.  If not, see                           *
+ * <http://www.gnu.org/licenses/>.                                        *
+ *************************************************************************/
+#pragma once
+
+// Tests/MathCheck.cpp builds this header without JUCE, and sets the JUCE_USE_* flags itself.
+#ifndef CONTROLGRIS_MATH_STANDALONE
+ #include "../JuceLibraryCode/JuceHeader.h"
+#else
+ #include <cmath>
+#endif
+
+// Polynomial approximations of sin, cos and atan2 used for the coordinate
+// conversions and the trajectory generators. Maximum absolute error, against
+// the double precision functions:
+//   sin, cos: 2.7e-7 for |x| <= 2 pi, 1.3e-6 for |x| <= 8 pi (range reduction is done in float).
+//   atan2:    2.8e-7 radian (1.6e-5 degree).
+//
+// Define CONTROLGRIS_FAST_MATH=0 to use the standard library functions instead.
+#ifndef CONTROLGRIS_FAST_MATH
+ #define CONTROLGRIS_FAST_MATH 1
+#endif
+
+// Called with the number of values each time sin, cos or atan2 is evaluated.
+// Tests/TrigCount.cpp defines it to count them.
+#ifndef CONTROLGRIS_MATH_COUNT
+ #define CONTROLGRIS_MATH_COUNT(numberOfValues)
+#endif
+
+#if JUCE_USE_SSE_INTRINSICS
+ #include <emmintrin.h>
+#elif JUCE_USE_ARM_NEON && defined (__aarch64__)
+ #include <arm_neon.h>
+ #define CONTROLGRIS_MATH_USE_NEON 1
+#endif
+
+static const float kMathPi = 3.14159265358979f;
+
+// Lane operations. The approximations are written once against this interface
+// and instantiated for plain floats and for the available vector instruction set.
+struct ScalarMathOps
+{
+    typedef float Vector;
+    typedef bool Mask;
+    static const int size = 1;
+
+    static inline Vector load(const float* p) { return *p; }
+    static inline void store(float* p, Vector a) { *p = a; }
+    static inline Vector set(float a) { return a; }
+    static inline Vector add(Vector a, Vector b) { return a + b; }
+    static inline Vector sub(Vector a, Vector b) { return a - b; }
+    static inline Vector mul(Vector a, Vector b) { return a * b; }
+    static inline Vector div(Vector a, Vector b) { return a / b; }
+    static inline Vector min(Vector a, Vector b) { return a < b ? a : b; }
+    static inline Vector max(Vector a, Vector b) { return a > b ? a : b; }
+    static inline Vector sqrt(Vector a) { return sqrtf(a); }
+    static inline Vector abs(Vector a) { return fabsf(a); }
+    static inline Vector round(Vector a) { return (float)(int)(a + (a >= 0.0f ? 0.5f : -0.5f)); }
+    static inline Mask lessThan(Vector a, Vector b) { return a < b; }
+    static inline Mask lessEqual(Vector a, Vector b) { return a <= b; }
+    static inline Mask greaterThan(Vector a, Vector b) { return a > b; }
+    static inline Mask notEqual(Vector a, Vector b) { return a != b; }
+    static inline Mask either(Mask a, Mask b) { return a || b; }
+    static inline Mask both(Mask a, Mask b) { return a && b; }
+    static inline Vector lanes() { return 0.0f; }
+    static inline Vector select(Mask m, Vector a, Vector b) { return m ? a : b; }
+
+    static Vector sin(Vector a);
+    static Vector cos(Vector a);
+    static Vector atan2(Vector a, Vector b);
+};
+
+#if CONTROLGRIS_FAST_MATH && JUCE_USE_SSE_INTRINSICS
+ #define CONTROLGRIS_MATH_HAS_VECTOR_OPS 1
+struct VectorMathOps
+{
+    typedef __m128 Vector;
+    typedef __m128 Mask;
+    static const int size = 4;
+
+    static inline Vector load(const float* p) { return _mm_load_ps(p); }
+    static inline void store(float* p, Vector a) { _mm_store_ps(p, a); }
+    static inline Vector set(float a) { return _mm_set1_ps(a); }
+    static inline Vector add(Vector a, Vector b) { return _mm_add_ps(a, b); }
+    static inline Vector sub(Vector a, Vector b) { return _mm_sub_ps(a, b); }
+    static inline Vector mul(Vector a, Vector b) { return _mm_mul_ps(a, b); }
+    static inline Vector div(Vector a, Vector b) { return _mm_div_ps(a, b); }
+    static inline Vector min(Vector a, Vector b) { return _mm_min_ps(a, b); }
+    static inline Vector max(Vector a, Vector b) { return _mm_max_ps(a, b); }
+    static inline Vector sqrt(Vector a) { return _mm_sqrt_ps(a); }
+    static inline Vector abs(Vector a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+    static inline Vector round(Vector a) { return _mm_cvtepi32_ps(_mm_cvtps_epi32(a)); }
+    static inline Mask lessThan(Vector a, Vector b) { return _mm_cmplt_ps(a, b); }
+    static inline Mask lessEqual(Vector a, Vector b) { return _mm_cmple_ps(a, b); }
+    static inline Mask greaterThan(Vector a, Vector b) { return _mm_cmpgt_ps(a, b); }
+    static inline Mask notEqual(Vector a, Vector b) { return _mm_cmpneq_ps(a, b); }
+    static inline Mask either(Mask a, Mask b) { return _mm_or_ps(a, b); }
+    static inline Mask both(Mask a, Mask b) { return _mm_and_ps(a, b); }
+    static inline Vector lanes() { return _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f); }
+    static inline Vector select(Mask m, Vector a, Vector b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+
+    static Vector sin(Vector a);
+    static Vector cos(Vector a);
+    static Vector atan2(Vector a, Vector b);
+};
+#elif CONTROLGRIS_FAST_MATH && CONTROLGRIS_MATH_USE_NEON
+ #define CONTROLGRIS_MATH_HAS_VECTOR_OPS 1
+struct VectorMathOps
+{
+    typedef float32x4_t Vector;
+    typedef uint32x4_t Mask;
+    static const int size = 4;
+
+    static inline Vector load(const float* p) { return vld1q_f32(p); }
+    static inline void store(float* p, Vector a) { vst1q_f32(p, a); }
+    static inline Vector set(float a) { return vdupq_n_f32(a); }
+    static inline Vector add(Vector a, Vector b) { return vaddq_f32(a, b); }
+    static inline Vector sub(Vector a, Vector b) { return vsubq_f32(a, b); }
+    static inline Vector mul(Vector a, Vector b) { return vmulq_f32(a, b); }
+    static inline Vector div(Vector a, Vector b) { return vdivq_f32(a, b); }
+    static inline Vector min(Vector a, Vector b) { return vminq_f32(a, b); }
+    static inline Vector max(Vector a, Vector b) { return vmaxq_f32(a, b); }
+    static inline Vector sqrt(Vector a) { return vsqrtq_f32(a); }
+    static inline Vector abs(Vector a) { return vabsq_f32(a); }
+    static inline Vector round(Vector a) { return vrndnq_f32(a); }
+    static inline Mask lessThan(Vector a, Vector b) { return vcltq_f32(a, b); }
+    static inline Mask lessEqual(Vector a, Vector b) { return vcleq_f32(a, b); }
+    static inline Mask greaterThan(Vector a, Vector b) { return vcgtq_f32(a, b); }
+    static inline Mask notEqual(Vector a, Vector b) { return vmvnq_u32(vceqq_f32(a, b)); }
+    static inline Mask either(Mask a, Mask b) { return vorrq_u32(a, b); }
+    static inline Mask both(Mask a, Mask b) { return vandq_u32(a, b); }
+    static inline Vector lanes() { const float values[4] = { 0.0f, 1.0f, 2.0f, 3.0f }; return vld1q_f32(values); }
+    static inline Vector select(Mask m, Vector a, Vector b) { return vbslq_f32(m, a, b); }
+
+    static Vector sin(Vector a);
+    static Vector cos(Vector a);
+    static Vector atan2(Vector a, Vector b);
+};
+#endif
+
+//==============================================================================
+// sin(x), for x in radians. The angle is wrapped to [-pi, pi], folded to
+// [-pi/2, pi/2] and evaluated with a degree 11 polynomial.
+template <typename Ops>
+inline typename Ops::Vector polynomialSin(typename Ops::Vector x) {
+    typedef typename Ops::Vector Vector;
+    const Vector pi = Ops::set(kMathPi);
+    const Vector halfPi = Ops::set(kMathPi * 0.5f);
+
+    x = Ops::sub(x, Ops::mul(Ops::set(2.0f * kMathPi), Ops::round(Ops::mul(x, Ops::set(0.5f / kMathPi)))));
+    x = Ops::select(Ops::greaterThan(x, halfPi), Ops::sub(pi, x), x);
+    x = Ops::select(Ops::lessThan(x, Ops::sub(Ops::set(0.0f), halfPi)), Ops::sub(Ops::sub(Ops::set(0.0f), pi), x), x);
+
+    Vector x2 = Ops::mul(x, x);
+    Vector p = Ops::set(-2.5052108e-8f);
+    p = Ops::add(Ops::mul(p, x2), Ops::set(2.7557319e-6f));
+    p = Ops::add(Ops::mul(p, x2), Ops::set(-1.9841270e-4f));
+    p = Ops::add(Ops::mul(p, x2), Ops::set(8.3333333e-3f));
+    p = Ops::add(Ops::mul(p, x2), Ops::set(-1.6666667e-1f));
+    p = Ops::add(Ops::mul(p, x2), Ops::set(1.0f));
+    return Ops::mul(p, x);
+}
+
+// atan2(a, b), in radians. The ratio is reduced to [0, tan(pi/8)] and evaluated
+// with the cephes atanf polynomial. Lanes where a and b are both 0 are undefined.
+template <typename Ops>
+inline typename Ops::Vector polynomialAtan2(typename Ops::Vector a, typename Ops::Vector b) {
+    typedef typename Ops::Vector Vector;
+    typedef typename Ops::Mask Mask;
+    const Vector zero = Ops::set(0.0f);
+    const Vector one = Ops::set(1.0f);
+
+    Vector absA = Ops::abs(a);
+    Vector absB = Ops::abs(b);
+    Mask swap = Ops::greaterThan(absA, absB);
+    Vector t = Ops::div(Ops::min(absA, absB), Ops::max(absA, absB));
+
+    Mask reduce = Ops::greaterThan(t, Ops::set(0.41421356f));
+    t = Ops::select(reduce, Ops::div(Ops::sub(t, one), Ops::add(t, one)), t);
+
+    Vector z = Ops::mul(t, t);
+    Vector p = Ops::set(8.05374449538e-2f);
+    p = Ops::add(Ops::mul(p, z), Ops::set(-1.38776856032e-1f));
+    p = Ops::add(Ops::mul(p, z), Ops::set(1.99777106478e-1f));
+    p = Ops::add(Ops::mul(p, z), Ops::set(-3.33329491539e-1f));
+    Vector r = Ops::add(Ops::mul(Ops::mul(p, z), t), t);
+
+    r = Ops::add(r, Ops::select(reduce, Ops::set(kMathPi * 0.25f), zero));
+    r = Ops::select(swap, Ops::sub(Ops::set(kMathPi * 0.5f), r), r);
+    r = Ops::select(Ops::lessThan(b, zero), Ops::sub(Ops::set(kMathPi), r), r);
+    return Ops::select(Ops::lessThan(a, zero), Ops::sub(zero, r), r);
+}
+
+//==============================================================================
+inline float fastSin(float x) {
+    CONTROLGRIS_MATH_COUNT(1);
+#if CONTROLGRIS_FAST_MATH
+    return polynomialSin<ScalarMathOps>(x);
+#else
+    return sinf(x);
+#endif
+}
+
+inline float fastCos(float x) {
+    CONTROLGRIS_MATH_COUNT(1);
+#if CONTROLGRIS_FAST_MATH
+    return polynomialSin<ScalarMathOps>(x + kMathPi * 0.5f);
+#else
+    return cosf(x);
+#endif
+}
+
+// Same argument order as atan2f. Returns 0 when y and x are both 0.
+inline float fastAtan2(float y, float x) {
+    CONTROLGRIS_MATH_COUNT(1);
+#if CONTROLGRIS_FAST_MATH
+    return (y == 0.0f && x == 0.0f) ? 0.0f : polynomialAtan2<ScalarMathOps>(y, x);
+#else
+    return atan2f(y, x);
+#endif
+}
+
+inline float ScalarMathOps::sin(float a) { return fastSin(a); }
+inline float ScalarMathOps::cos(float a) { return fastCos(a); }
+inline float ScalarMathOps::atan2(float a, float b) { return fastAtan2(a, b); }
+
+#if CONTROLGRIS_MATH_HAS_VECTOR_OPS
+inline VectorMathOps::Vector VectorMathOps::sin(Vector a) {
+    CONTROLGRIS_MATH_COUNT(size);
+    return polynomialSin<VectorMathOps>(a);
+}
+
+inline VectorMathOps::Vector VectorMathOps::cos(Vector a) {
+    CONTROLGRIS_MATH_COUNT(size);
+    return polynomialSin<VectorMathOps>(add(a, set(kMathPi * 0.5f)));
+}
+
+inline VectorMathOps::Vector VectorMathOps::atan2(Vector a, Vector b) {
+    CONTROLGRIS_MATH_COUNT(size);
+    return polynomialAtan2<VectorMathOps>(a, b);
+}
+#endif
@@ -20,6 +20,7 @@
 #include "../JuceLibraryCode/JuceHeader.h"
 #include "FieldComponent.h"
 #include "ControlGrisConstants.h"
+#include "ControlGrisMath.h"
 
 //==============================================================================
 FieldComponent::FieldComponent()
@@ -149,8 +150,8 @@ Point <float> MainFieldComponent::degreeToXy(Point <float> p, int p_iwidth) {
     float effectiveWidth = p_iwidth - kSourceDiameter;
     float radius = effectiveWidth / 2.0;
     float distance = (90.0 - p.getY()) / 90.0;
-    float x = radius * distance * sinf(degreeToRadian(p.getX())) + radius;
-    float y = radius * distance * cosf(degreeToRadian(p.getX())) + radius;
+    float x = radius * distance * fastSin(degreeToRadian(p.getX())) + radius;
+    float y = radius * distance * fastCos(degreeToRadian(p.getX())) + radius;
     return Point <float> (effectiveWidth - x, effectiveWidth - y);
 }
 
@@ -159,7 +160,7 @@ Point <float> MainFieldComponent::xyToDegree(Point <float> p, int p_iwidth) {
     float half = (p_iwidth - kSourceDiameter) / 2;
     float x = (p.getX() - k2 - half) / half;
     float y = (p.getY() - k2 - half) / half;
-    float ang = atan2f(x, y) / M_PI * 180.0;
+    float ang = fastAtan2(x, y) / M_PI * 180.0;
     if (ang <= -180) {
         ang += 360.0;
     }
@@ -204,10 +205,10 @@ void MainFieldComponent::createSpanPathVBAP(Graphics& g, int i) {
 
     // Convert min and max elevation to xy position.
     float halfWidth = (width - kSourceDiameter) / 2.0f;
-    Point<float> minElevPos = {-halfWidth * sinf(degreeToRadian(minElev.getX())) * (90.0f - minElev.getY()) / 90.0f,
-                                -halfWidth * cosf(degreeToRadian(minElev.getX())) * (90.0f - minElev.getY()) / 90.0f};
-    Point<float> maxElevPos = {-halfWidth * sinf(degreeToRadian(maxElev.getX())) * (90.0f - maxElev.getY()) / 90.0f,
-                                -halfWidth * cosf(degreeToRadian(maxElev.getX())) * (90.0f - maxElev.getY()) / 90.0f};
+    Point<float> minElevPos = {-halfWidth * fastSin(degreeToRadian(minElev.getX())) * (90.0f - minElev.getY()) / 90.0f,
+                                -halfWidth * fastCos(degreeToRadian(minElev.getX())) * (90.0f - minElev.getY()) / 90.0f};
+    Point<float> maxElevPos = {-halfWidth * fastSin(degreeToRadian(maxElev.getX())) * (90.0f - maxElev.getY()) / 90.0f,
+                                -halfWidth * fastCos(degreeToRadian(maxElev.getX())) * (90.0f - maxElev.getY()) / 90.0f};
 
     // Calculate min and max radius.
     float minRadius = sqrtf(minElevPos.getX()*minElevPos.getX() + minElevPos.getY()*minElevPos.getY());
@@ -296,7 +297,7 @@ void MainFieldComponent::paint(Graphics& g) {
         lineDrawingPath.closeSubPath();
         g.strokePath(lineDrawingPath, PathStrokeType(.75f));
     }
-    if (automationManager.getRecordingTrajectorySize() > 1) {
+    if (automationManager.hasTrajectoryPath()) {
         Path trajectoryPath;
         automationManager.createRecordingPath(trajectoryPath);
         g.strokePath(trajectoryPath, PathStrokeType(.75f));
@@ -382,12 +383,7 @@ void MainFieldComponent::mouseDown(const MouseEvent &event) {
     if (hasValidLineDrawingAnchor1()) {
         Point<float> anchor1 = lineDrawingAnchor1;
         Point<float> anchor2 = clipRecordingPosition(event.getPosition()).toFloat();
-        int numSteps = (int)jmax(abs(anchor2.x - anchor1.x), abs(anchor2.y - anchor1.y));
-        float xinc = (anchor2.x - anchor1.x) / numSteps;
-        float yinc = (anchor2.y - anchor1.y) / numSteps;
-        for (int i = 1; i <= numSteps; i++) {
-            automationManager.addRecordingPoint(Point<float> (anchor1.x + xinc * i, anchor1.y + yinc * i));
-        }
+        automationManager.addRecordingLine(anchor1, anchor2);
         if (event.mods.isShiftDown()) {
             lineDrawingAnchor1 = anchor2;
             lineDrawingAnchor2 = Point<float> (-1.0f, -1.0f);
@@ -537,6 +533,7 @@ void MainFieldComponent::mouseUp(const MouseEvent &event) {
     if (m_selectedSourceId == -1) {
         if (automationManager.getDrawingType() == TRAJECTORY_TYPE_DRAWING && ! event.mods.isShiftDown()) {
             automationManager.addRecordingPoint(automationManager.getLastRecordingPoint());
+            automationManager.finishRecordingTrajectory();
             m_selectedSourceId = m_oldSelectedSourceId;
         }
         repaint();
@@ -598,7 +595,7 @@ void ElevationFieldComponent::paint(Graphics& g) {
 
     // Draw recording trajectory path and current position dot.
     g.setColour(Colour::fromRGB(176, 176, 228));
-    if (automationManager.getRecordingTrajectorySize() > 1) {
+    if (automationManager.hasTrajectoryPath()) {
         Path trajectoryPath;
         automationManager.createRecordingPath(trajectoryPath);
         g.strokePath(trajectoryPath, PathStrokeType(.75f));
@@ -749,6 +746,7 @@ void ElevationFieldComponent::mouseUp(const MouseEvent &event) {
     if (m_selectedSourceId == -1) {
         if (automationManager.getDrawingType() == TRAJECTORY_TYPE_ALT_DRAWING) {
             automationManager.addRecordingPoint(automationManager.getLastRecordingPoint());
+            automationManager.finishRecordingTrajectory();
             m_selectedSourceId = m_oldSelectedSourceId;
         }
         repaint();
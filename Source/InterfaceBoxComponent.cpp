@@ -123,6 +123,9 @@ InterfaceBoxComponent::InterfaceBoxComponent() {
         };
 
     addAndMakeVisible(&oscSendPortEditor);
+
+    setOscStatistics(0, 0, 0);
+    addAndMakeVisible(&oscStatisticsLabel);
 }
 
 InterfaceBoxComponent::~InterfaceBoxComponent() {
@@ -163,6 +166,14 @@ void InterfaceBoxComponent::setOscSendOutputAddress(String address) {
     oscSendIpEditor.setText(address);
 }
 
+//==============================================================================
+void InterfaceBoxComponent::setOscStatistics(int inputDropped, int inputUnknown, int outputDropped) {
+    String text = String("Input dropped: ") + String(inputDropped) +
+                  String("   Unknown: ") + String(inputUnknown) +
+                  String("   Output dropped: ") + String(outputDropped);
+    oscStatisticsLabel.setText(text, NotificationType::dontSendNotification);
+}
+
 //==============================================================================
 void InterfaceBoxComponent::paint(Graphics& g) {
     GrisLookAndFeel *lookAndFeel;
@@ -188,4 +199,6 @@ void InterfaceBoxComponent::resized() {
     oscSendToggle.setBounds(255, 35, 200, 20);
     oscSendPortEditor.setBounds(400, 35, 60, 20);
     oscSendIpEditor.setBounds(470, 35, 120, 20);
+
+    oscStatisticsLabel.setBounds(5, 60, 585, 20);
 }
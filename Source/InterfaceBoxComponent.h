@@ -42,6 +42,8 @@ public:
     void setOscSendOutputAddress(String address);
     void setOscSendOutputPort(int port);
 
+    void setOscStatistics(int inputDropped, int inputUnknown, int outputDropped);
+
     struct Listener
     {
         virtual ~Listener() {}
@@ -75,6 +77,8 @@ private:
     TextEditor      oscSendIpEditor;
     TextEditor      oscSendPortEditor;
 
+    Label           oscStatisticsLabel;
+
     int lastOscReceivePort;
     int lastOscSendPort;
     String lastOscSendAddress;
@@ -0,0 +1,163 @@
+/**************************************************************************
+ * Copyright 2018 UdeM - GRIS - Olivier Belanger                          *
+ *                                                                        *
+ * This file is part of ControlGris, a multi-source spatialization plugin *
+ *                                                                        *
+ * ControlGris is free software: you can redistribute it and/or modify    *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * ControlGris is distributed in the hope that it will be useful,         *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with ControlGris.  If not, see                           *
+ * <http://www.gnu.org/licenses/>.                                        *
+ *************************************************************************/
+#include "OscSenderThread.h"
+
+OscSenderThread::OscSenderThread()
+    : Thread("ControlGris OSC sender"), fifo(kQueueSize)
+{
+    maxQueueDepth = 0;
+    droppedFrameCount = 0;
+    sendErrorCount = 0;
+    bundleMode = false;
+    maxDatagramSize = DEFAULT_OSC_MAX_DATAGRAM_SIZE;
+    portNumber = 0;
+    connected = false;
+}
+
+OscSenderThread::~OscSenderThread() {
+    stopThread(1000);
+    disconnect();
+}
+
+bool OscSenderThread::connect(const String& targetHostName, int targetPortNumber) {
+    const ScopedLock lock (senderLock);
+    socket.reset(new DatagramSocket(true));
+    hostName = targetHostName;
+    portNumber = targetPortNumber;
+    connected = socket->bindToPort(0);
+    if (! connected) {
+        socket.reset();
+    }
+    return connected;
+}
+
+bool OscSenderThread::disconnect() {
+    const ScopedLock lock (senderLock);
+    socket.reset();
+    connected = false;
+    return true;
+}
+
+void OscSenderThread::setBundleMode(bool shouldUseBundles) {
+    bundleMode = shouldUseBundles;
+}
+
+bool OscSenderThread::getBundleMode() const {
+    return bundleMode;
+}
+
+void OscSenderThread::setMaxDatagramSize(int numBytes) {
+    maxDatagramSize = jlimit(MIN_OSC_MAX_DATAGRAM_SIZE, MAX_OSC_MAX_DATAGRAM_SIZE, numBytes);
+}
+
+int OscSenderThread::getMaxDatagramSize() const {
+    return maxDatagramSize;
+}
+
+bool OscSenderThread::pushFrame(const SpatServFrame& frame) {
+    int start1, size1, start2, size2;
+    fifo.prepareToWrite(1, start1, size1, start2, size2);
+    if (size1 + size2 == 0) {
+        droppedFrameCount++;
+        return false;
+    }
+
+    frames[size1 > 0 ? start1 : start2] = frame;
+    fifo.finishedWrite(1);
+
+    int depth = fifo.getNumReady();
+    if (depth > maxQueueDepth) {
+        maxQueueDepth = depth;
+    }
+
+    return true;
+}
+
+void OscSenderThread::flush() {
+    notify();
+}
+
+int OscSenderThread::getQueueDepth() const {
+    return fifo.getNumReady();
+}
+
+int OscSenderThread::getMaxQueueDepth() const {
+    return maxQueueDepth;
+}
+
+int OscSenderThread::getDroppedFrameCount() const {
+    return droppedFrameCount;
+}
+
+int OscSenderThread::getSendErrorCount() const {
+    return sendErrorCount;
+}
+
+void OscSenderThread::resetCounters() {
+    maxQueueDepth = 0;
+    droppedFrameCount = 0;
+    sendErrorCount = 0;
+}
+
+void OscSenderThread::run() {
+    while (! threadShouldExit()) {
+        wait(-1);
+        sendPendingFrames();
+    }
+}
+
+void OscSenderThread::sendPendingFrames() {
+    const ScopedLock lock (senderLock);
+
+    const bool useBundles = bundleMode;
+    const int maxNumBundleMessages = encoder.getMaxNumBundleMessages(maxDatagramSize);
+    int numBundleMessages = 0;
+
+    int start1, size1, start2, size2;
+    fifo.prepareToRead(fifo.getNumReady(), start1, size1, start2, size2);
+
+    for (int i = 0; i < size1 + size2; i++) {
+        const SpatServFrame& frame = frames[i < size1 ? start1 + i : start2 + i - size1];
+        if (! connected) {
+            continue;
+        }
+        if (useBundles) {
+            if (numBundleMessages == maxNumBundleMessages) {
+                sendDatagram(encoder.getBundleData(), SpatServEncoder::getBundleSize(numBundleMessages));
+                numBundleMessages = 0;
+            }
+            encoder.setBundleMessage(numBundleMessages++, frame);
+        } else {
+            sendDatagram(encoder.encodeMessage(frame), SpatServEncoder::kMessageSize);
+        }
+    }
+
+    if (numBundleMessages > 0) {
+        sendDatagram(encoder.getBundleData(), SpatServEncoder::getBundleSize(numBundleMessages));
+    }
+
+    fifo.finishedRead(size1 + size2);
+}
+
+void OscSenderThread::sendDatagram(const char* data, int numBytes) {
+    if (socket->write(hostName, portNumber, data, numBytes) != numBytes) {
+        sendErrorCount++;
+    }
+}
@@ -0,0 +1,87 @@
+/**************************************************************************
+ * Copyright 2018 UdeM - GRIS - Olivier Belanger                          *
+ *                                                                        *
+ * This file is part of ControlGris, a multi-source spatialization plugin *
+ *                                                                        *
+ * ControlGris is free software: you can redistribute it and/or modify    *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * ControlGris is distributed in the hope that it will be useful,         *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with ControlGris.  If not, see                           *
+ * <http://www.gnu.org/licenses/>.                                        *
+ *************************************************************************/
+#pragma once
+
+#include <atomic>
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "ControlGrisConstants.h"
+#include "SpatServEncoder.h"
+
+// Sends the /spat/serv messages from its own thread, as raw datagrams
+// written by a SpatServEncoder. Frames are pushed in a
+// preallocated single-producer/single-consumer fifo, so pushFrame() never blocks
+// nor allocates. All frames must be pushed from the same thread, and are sent
+// when flush() is called, once all the frames of a tick have been pushed.
+//
+// In bundle mode, all pending frames are packed in as few OSC bundles as
+// possible, a new bundle being started when the datagram size would exceed
+// the maximum size. Otherwise, every frame is sent in its own datagram.
+class OscSenderThread : public Thread
+{
+public:
+    OscSenderThread();
+    ~OscSenderThread();
+
+    bool connect(const String& targetHostName, int targetPortNumber);
+    bool disconnect();
+
+    void setBundleMode(bool shouldUseBundles);
+    bool getBundleMode() const;
+    void setMaxDatagramSize(int numBytes);
+    int getMaxDatagramSize() const;
+
+    // Returns false if the fifo is full and the frame has been dropped.
+    bool pushFrame(const SpatServFrame& frame);
+    // Wakes up the sender thread to send the frames pushed so far.
+    void flush();
+
+    int getQueueDepth() const;
+    int getMaxQueueDepth() const;
+    int getDroppedFrameCount() const;
+    int getSendErrorCount() const;
+    void resetCounters();
+
+    void run() override;
+
+private:
+    void sendPendingFrames();
+    void sendDatagram(const char* data, int numBytes);
+
+    static const int kQueueSize = 1024;
+
+    AbstractFifo fifo;
+    SpatServFrame frames[kQueueSize];
+
+    std::atomic<int> maxQueueDepth;
+    std::atomic<int> droppedFrameCount;
+    std::atomic<int> sendErrorCount;
+
+    std::atomic<bool> bundleMode;
+    std::atomic<int> maxDatagramSize;
+
+    CriticalSection senderLock;
+    SpatServEncoder encoder;
+    std::unique_ptr<DatagramSocket> socket;
+    String hostName;
+    int portNumber;
+    bool connected;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OscSenderThread)
+};
@@ -138,6 +138,11 @@ void ControlGrisAudioProcessorEditor::setPluginState() {
     //----------------------------
     settingsBoxOscFormatChanged(processor.getOscFormat());
     settingsBoxOscPortNumberChanged(processor.getOscPortNumber());
+    settingsBoxOscOutputRateChanged(processor.getOscOutputRate());
+    settingsBoxOscBundleModeChanged(processor.getOscBundleMode());
+    settingsBoxOscMaxDatagramSizeChanged(processor.getOscMaxDatagramSize());
+    settingsBoxOscKeepAliveIntervalChanged(processor.getOscKeepAliveInterval());
+    settingsBoxRecordingCapacityChanged(processor.getRecordingCapacity());
     settingsBoxOscActivated(processor.getOscConnected());
     settingsBoxFirstSourceIdChanged(processor.getFirstSourceId());
     settingsBoxNumberOfSourcesChanged(processor.getNumberOfSources());
@@ -154,14 +159,14 @@ void ControlGrisAudioProcessorEditor::setPluginState() {
     //------------------------------------------------
     trajectoryBox.setTrajectoryType(valueTreeState.state.getProperty("trajectoryType", 1));
     trajectoryBox.setTrajectoryTypeAlt(valueTreeState.state.getProperty("trajectoryTypeAlt", 1));
+    // Both fields show the back and forth and dampening settings of the same 3D trajectory.
     trajectoryBox.setBackAndForth(valueTreeState.state.getProperty("backAndForth", false));
-    trajectoryBox.setBackAndForthAlt(valueTreeState.state.getProperty("backAndForthAlt", false));
+    trajectoryBox.setBackAndForthAlt(valueTreeState.state.getProperty("backAndForth", false));
     trajectoryBox.setDampeningCycles(valueTreeState.state.getProperty("dampeningCycles", 0));
-    automationManager.setDampeningCycles(valueTreeState.state.getProperty("dampeningCycles", 0));
-    trajectoryBox.setDampeningCyclesAlt(valueTreeState.state.getProperty("dampeningCyclesAlt", 0));
-    automationManagerAlt.setDampeningCycles(valueTreeState.state.getProperty("dampeningCyclesAlt", 0));
+    trajectoryBox.setDampeningCyclesAlt(valueTreeState.state.getProperty("dampeningCycles", 0));
     trajectoryBox.setDeviationPerCycle(valueTreeState.state.getProperty("deviationPerCycle", 0));
-    automationManager.setDeviationPerCycle(valueTreeState.state.getProperty("deviationPerCycle", 0));
+    trajectoryBox.setConstantSpeed(valueTreeState.state.getProperty("constantSpeed", false));
+    trajectoryBox.setRecordedTiming(valueTreeState.state.getProperty("recordedTiming", false));
     trajectoryBox.setCycleDuration(valueTreeState.state.getProperty("cycleDuration", 5.0));
     trajectoryBox.setDurationUnit(valueTreeState.state.getProperty("durationUnit", 1));
 
@@ -184,6 +189,7 @@ void ControlGrisAudioProcessorEditor::setPluginState() {
     elevationField.setSelectedSource(m_selectedSource);
     processor.setSelectedSourceId(m_selectedSource);
     sourceBox.updateSelectedSource(&processor.getSources()[m_selectedSource], m_selectedSource, processor.getOscFormat());
+    updateSourceBoxTrajectory();
 
     int preset = (int)((float)valueTreeState.getParameterAsValue("positionPreset").getValue());
     positionPresetBox.setPreset(preset, true);
@@ -231,12 +237,38 @@ void ControlGrisAudioProcessorEditor::settingsBoxOscPortNumberChanged(int oscPor
     settingsBox.setOscPortNumber(oscPort);
 }
 
+void ControlGrisAudioProcessorEditor::settingsBoxOscOutputRateChanged(int rate) {
+    processor.setOscOutputRate(rate);
+    settingsBox.setOscOutputRate(processor.getOscOutputRate());
+}
+
+void ControlGrisAudioProcessorEditor::settingsBoxOscBundleModeChanged(bool shouldUseBundles) {
+    processor.setOscBundleMode(shouldUseBundles);
+    settingsBox.setOscBundleMode(shouldUseBundles);
+}
+
+void ControlGrisAudioProcessorEditor::settingsBoxOscMaxDatagramSizeChanged(int numBytes) {
+    processor.setOscMaxDatagramSize(numBytes);
+    settingsBox.setOscMaxDatagramSize(processor.getOscMaxDatagramSize());
+}
+
+void ControlGrisAudioProcessorEditor::settingsBoxOscKeepAliveIntervalChanged(int milliseconds) {
+    processor.setOscKeepAliveInterval(milliseconds);
+    settingsBox.setOscKeepAliveInterval(processor.getOscKeepAliveInterval());
+}
+
+void ControlGrisAudioProcessorEditor::settingsBoxRecordingCapacityChanged(int numberOfPoints) {
+    processor.setRecordingCapacity(numberOfPoints);
+    settingsBox.setRecordingCapacity(processor.getRecordingCapacity());
+}
+
 void ControlGrisAudioProcessorEditor::settingsBoxOscActivated(bool state) {
     processor.handleOscConnection(state);
     settingsBox.setActivateButtonState(processor.getOscConnected());
 }
 
 void ControlGrisAudioProcessorEditor::settingsBoxNumberOfSourcesChanged(int numOfSources) {
+    numOfSources = jlimit(1, MAX_NUMBER_OF_SOURCES, numOfSources);
     bool initSourcePlacement = false;
     if (processor.getNumberOfSources() != numOfSources || m_isInsideSetPluginState) {
         if (processor.getNumberOfSources() != numOfSources) {
@@ -283,14 +315,20 @@ void ControlGrisAudioProcessorEditor::sourceBoxSelectionChanged(int sourceNum) {
     elevationField.setSelectedSource(m_selectedSource);
     processor.setSelectedSourceId(m_selectedSource);
     sourceBox.updateSelectedSource(&processor.getSources()[m_selectedSource], m_selectedSource, processor.getOscFormat());
+    updateSourceBoxTrajectory();
+}
+
+// Azimuth of a source in the alternate placements. Sources are spread on an even
+// number of positions, alternating on each side of the front axis
+// (e.g. -45, 45, -135, 135 for 4 sources).
+static float getAlternatePlacementAzimuth(int index, int numOfSources) {
+    int numOfPositions = numOfSources + numOfSources % 2;
+    float azimuth = 360.0f / numOfPositions * (index / 2 + 0.5f);
+    return index % 2 == 0 ? -azimuth : azimuth;
 }
 
 void ControlGrisAudioProcessorEditor::sourceBoxPlacementChanged(int value) {
     int numOfSources = processor.getNumberOfSources();
-    const float azims2[2] = {-90.0f, 90.0f};
-    const float azims4[4] = {-45.0f, 45.0f, -135.0f, 135.0f};
-    const float azims6[6] = {-30.0f, 30.0f, -90.0f, 90.0f, -150.0f, 150.0f};
-    const float azims8[8] = {-22.5f, 22.5f, -67.5f, 67.5f, -112.5f, 112.5f, -157.5f, 157.5f};
 
     bool isLBAP = processor.getOscFormat() == SPAT_MODE_LBAP;
 
@@ -300,26 +338,14 @@ void ControlGrisAudioProcessorEditor::sourceBoxPlacementChanged(int value) {
     switch(value) {
         case SOURCE_PLACEMENT_LEFT_ALTERNATE:
             for (int i = 0; i < numOfSources; i++) {
-                if (numOfSources <= 2)
-                    processor.getSources()[i].setCoordinates(-azims2[i], isLBAP ? processor.getSources()[i].getElevation() : 0.0f, distance);
-                else if (numOfSources <= 4)
-                    processor.getSources()[i].setCoordinates(-azims4[i], isLBAP ? processor.getSources()[i].getElevation() : 0.0f, distance);
-                else if (numOfSources <= 6)
-                    processor.getSources()[i].setCoordinates(-azims6[i], isLBAP ? processor.getSources()[i].getElevation() : 0.0f, distance);
-                else
-                    processor.getSources()[i].setCoordinates(-azims8[i], isLBAP ? processor.getSources()[i].getElevation() : 0.0f, distance);
+                float azimuth = getAlternatePlacementAzimuth(i, numOfSources);
+                processor.getSources()[i].setCoordinates(-azimuth, isLBAP ? processor.getSources()[i].getElevation() : 0.0f, distance);
             }
             break;
         case SOURCE_PLACEMENT_RIGHT_ALTERNATE:
             for (int i = 0; i < numOfSources; i++) {
-                if (numOfSources <= 2)
-                    processor.getSources()[i].setCoordinates(azims2[i], isLBAP ? processor.getSources()[i].getElevation() : 0.0f, distance);
-                else if (numOfSources <= 4)
-                    processor.getSources()[i].setCoordinates(azims4[i], isLBAP ? processor.getSources()[i].getElevation() : 0.0f, distance);
-                else if (numOfSources <= 6)
-                    processor.getSources()[i].setCoordinates(azims6[i], isLBAP ? processor.getSources()[i].getElevation() : 0.0f, distance);
-                else
-                    processor.getSources()[i].setCoordinates(azims8[i], isLBAP ? processor.getSources()[i].getElevation() : 0.0f, distance);
+                float azimuth = getAlternatePlacementAzimuth(i, numOfSources);
+                processor.getSources()[i].setCoordinates(azimuth, isLBAP ? processor.getSources()[i].getElevation() : 0.0f, distance);
             }
             break;
         case SOURCE_PLACEMENT_LEFT_CLOCKWISE:
@@ -386,6 +412,26 @@ void ControlGrisAudioProcessorEditor::sourceBoxPositionChanged(int sourceNum, fl
     repaint();
 }
 
+void ControlGrisAudioProcessorEditor::sourceBoxTrajectoryChanged(int sourceNum, int drawingType, double period, double phase) {
+    if (drawingType < TRAJECTORY_TYPE_CIRCLE_CLOCKWISE) {
+        processor.clearSourceTrajectory(sourceNum);
+    } else if (processor.hasSourceTrajectory(sourceNum) &&
+               processor.getSourceTrajectories().getDrawingType(sourceNum) == drawingType) {
+        processor.setSourceTrajectoryTiming(sourceNum, period, phase);
+    } else {
+        // A new shape starts from where the source is now.
+        processor.setSourceTrajectory(sourceNum, drawingType, processor.getSources()[sourceNum].getPos(), period, phase);
+    }
+    updateSourceBoxTrajectory();
+}
+
+void ControlGrisAudioProcessorEditor::updateSourceBoxTrajectory() {
+    const SourceTrajectories& trajectories = processor.getSourceTrajectories();
+    int drawingType = trajectories.hasTrajectory(m_selectedSource) ? trajectories.getDrawingType(m_selectedSource) : 0;
+    sourceBox.updateSelectedSourceTrajectory(drawingType, trajectories.getPeriod(m_selectedSource),
+                                             trajectories.getPhaseOffset(m_selectedSource));
+}
+
 // ParametersBoxComponent::Listener callbacks.
 //--------------------------------------------
 void ControlGrisAudioProcessorEditor::parametersBoxParameterChanged(int parameterId, double value) {
@@ -431,47 +477,52 @@ void ControlGrisAudioProcessorEditor::trajectoryBoxTrajectoryTypeAltChanged(int
 
 void ControlGrisAudioProcessorEditor::trajectoryBoxBackAndForthChanged(bool value) {
     valueTreeState.state.setProperty("backAndForth", value, nullptr);
-    automationManager.setBackAndForth(value);
+    processor.trajectoryManager.setBackAndForth(value);
+    trajectoryBox.setBackAndForthAlt(value);
 }
 
 void ControlGrisAudioProcessorEditor::trajectoryBoxBackAndForthAltChanged(bool value) {
-    valueTreeState.state.setProperty("backAndForthAlt", value, nullptr);
-    automationManagerAlt.setBackAndForth(value);
+    valueTreeState.state.setProperty("backAndForth", value, nullptr);
+    processor.trajectoryManager.setBackAndForth(value);
+    trajectoryBox.setBackAndForth(value);
 }
 
 void ControlGrisAudioProcessorEditor::trajectoryBoxDampeningCyclesChanged(int value) {
     valueTreeState.state.setProperty("dampeningCycles", value, nullptr);
-    automationManager.setDampeningCycles(value);
+    processor.trajectoryManager.setDampeningCycles(value);
+    trajectoryBox.setDampeningCyclesAlt(value);
 }
 
 void ControlGrisAudioProcessorEditor::trajectoryBoxDampeningCyclesAltChanged(int value) {
-    valueTreeState.state.setProperty("dampeningCyclesAlt", value, nullptr);
-    automationManagerAlt.setDampeningCycles(value);
+    valueTreeState.state.setProperty("dampeningCycles", value, nullptr);
+    processor.trajectoryManager.setDampeningCycles(value);
+    trajectoryBox.setDampeningCycles(value);
 }
 
 void ControlGrisAudioProcessorEditor::trajectoryBoxDeviationPerCycleChanged(float value) {
     valueTreeState.state.setProperty("deviationPerCycle", value, nullptr);
-    automationManager.setDeviationPerCycle(value);
+    processor.trajectoryManager.setDeviationPerCycle(value);
+}
+
+void ControlGrisAudioProcessorEditor::trajectoryBoxConstantSpeedChanged(bool value) {
+    valueTreeState.state.setProperty("constantSpeed", value, nullptr);
+    processor.trajectoryManager.setConstantSpeed(value);
+}
+
+void ControlGrisAudioProcessorEditor::trajectoryBoxRecordedTimingChanged(bool value) {
+    valueTreeState.state.setProperty("recordedTiming", value, nullptr);
+    processor.trajectoryManager.setRecordedTiming(value);
 }
 
 void ControlGrisAudioProcessorEditor::trajectoryBoxCycleDurationChanged(double duration, int mode) {
     valueTreeState.state.setProperty("cycleDuration", duration, nullptr);
-    double dur = duration;
-    if (mode == 2) {
-        dur = duration * 60.0 / processor.getBPM();
-    }
-    automationManager.setPlaybackDuration(dur);
-    automationManagerAlt.setPlaybackDuration(dur);
+    // Beats and bars are converted with the host position, so the cycle follows tempo changes.
+    processor.trajectoryManager.setPlaybackDuration(duration, mode);
 }
 
 void ControlGrisAudioProcessorEditor::trajectoryBoxDurationUnitChanged(double duration, int mode) {
     valueTreeState.state.setProperty("durationUnit", mode, nullptr);
-    double dur = duration;
-    if (mode == 2) {
-        dur = duration * 60.0 / processor.getBPM();
-    }
-    automationManager.setPlaybackDuration(dur);
-    automationManagerAlt.setPlaybackDuration(dur);
+    processor.trajectoryManager.setPlaybackDuration(duration, mode);
 }
 
 void ControlGrisAudioProcessorEditor::trajectoryBoxActivateChanged(bool value) {
@@ -487,6 +538,7 @@ void ControlGrisAudioProcessorEditor::trajectoryBoxActivateAltChanged(bool value
 void ControlGrisAudioProcessorEditor::refresh() {
     parametersBox.setSelectedSource(&processor.getSources()[m_selectedSource]);
     sourceBox.updateSelectedSource(&processor.getSources()[m_selectedSource], m_selectedSource, processor.getOscFormat());
+    updateSourceBoxTrajectory();
 
     mainField.setIsPlaying(processor.getIsPlaying());
     elevationField.setIsPlaying(processor.getIsPlaying());
@@ -501,6 +553,9 @@ void ControlGrisAudioProcessorEditor::refresh() {
     if (trajectoryBox.getActivateAltState() != automationManagerAlt.getActivateState()) {
         trajectoryBox.setActivateAltState(automationManagerAlt.getActivateState());
     }
+
+    interfaceBox.setOscStatistics(processor.getOscControlDroppedCount(), processor.getOscUnknownAddressCount(),
+                                  processor.getOscDroppedFrameCount());
 }
 
 // FieldComponent::Listener callback.
@@ -65,6 +65,11 @@ public:
     // SettingsBoxComponent::Listeners
     void settingsBoxOscFormatChanged(SPAT_MODE_ENUM mode) override;
     void settingsBoxOscPortNumberChanged(int oscPort) override;
+    void settingsBoxOscOutputRateChanged(int rate) override;
+    void settingsBoxOscBundleModeChanged(bool shouldUseBundles) override;
+    void settingsBoxOscMaxDatagramSizeChanged(int numBytes) override;
+    void settingsBoxOscKeepAliveIntervalChanged(int milliseconds) override;
+    void settingsBoxRecordingCapacityChanged(int numberOfPoints) override;
     void settingsBoxOscActivated(bool state) override;
     void settingsBoxNumberOfSourcesChanged(int numOfSources) override;
     void settingsBoxFirstSourceIdChanged(int firstSourceId) override;
@@ -73,6 +78,7 @@ public:
     void sourceBoxSelectionChanged(int sourceNum) override;
     void sourceBoxPlacementChanged(int value) override;
     void sourceBoxPositionChanged(int sourceNum, float angle, float rayLen) override;
+    void sourceBoxTrajectoryChanged(int sourceNum, int drawingType, double period, double phase) override;
 
     // TrajectoryBoxComponent::Listeners
     void trajectoryBoxSourceLinkChanged(int value) override;
@@ -84,6 +90,8 @@ public:
     void trajectoryBoxDampeningCyclesChanged(int value) override;
     void trajectoryBoxDampeningCyclesAltChanged(int value) override;
     void trajectoryBoxDeviationPerCycleChanged(float value) override;
+    void trajectoryBoxConstantSpeedChanged(bool value) override;
+    void trajectoryBoxRecordedTimingChanged(bool value) override;
     void trajectoryBoxCycleDurationChanged(double duration, int mode) override;
     void trajectoryBoxDurationUnitChanged(double duration, int mode) override;
     void trajectoryBoxActivateChanged(bool value) override;
@@ -143,5 +151,7 @@ private:
 
     Value lastUIWidth, lastUIHeight;
 
+    void updateSourceBoxTrajectory();
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ControlGrisAudioProcessorEditor)
 };
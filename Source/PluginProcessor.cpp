@@ -63,6 +63,11 @@ AudioProcessorValueTreeState::ParameterLayout createParameterLayout() {
     return { parameters.begin(), parameters.end() };
 }
 
+// Parameters notifying the processor of their changes.
+static const char* const listenedParameterIds[] = { "recordingTrajectory_x", "recordingTrajectory_y", "recordingTrajectory_z",
+                                                    "sourceLink", "sourceLinkAlt", "positionPreset",
+                                                    "azimuthSpan", "elevationSpan" };
+
 //==============================================================================
 ControlGrisAudioProcessor::ControlGrisAudioProcessor()
      :
@@ -77,6 +82,8 @@ ControlGrisAudioProcessor::ControlGrisAudioProcessor()
                        ),
 #endif
     parameters (*this, nullptr, Identifier(JucePlugin_Name), createParameterLayout()),
+    sourceBank (MAX_NUMBER_OF_SOURCES),
+    sourceTrajectories (MAX_NUMBER_OF_SOURCES),
     fixPositionData (FIXED_POSITION_DATA_TAG)
 {
     m_numOfSources = 2;
@@ -84,18 +91,27 @@ ControlGrisAudioProcessor::ControlGrisAudioProcessor()
     m_selectedSourceId = 1;
     m_selectedOscFormat = (SPAT_MODE_ENUM)0;
     m_currentOSCPort = 18032;
+    m_oscOutputRate = DEFAULT_OSC_OUTPUT_RATE;
+    m_oscKeepAliveInterval = DEFAULT_OSC_KEEP_ALIVE_INTERVAL;
+    m_oscFullRefreshRequested = true;
+    m_lastOscFullRefreshTime = 0.0;
     m_lastConnectedOSCPort = -1;
     m_oscConnected = true;
     m_oscInputConnected = false;
     m_currentOSCInputPort = 8000;
     m_oscOutputConnected = false;
     m_currentOSCOutputPort = 9000;
+    m_oscOutputPluginId = 1;
     m_currentOSCOutputAddress = String("192.168.1.100");
 
     m_initTimeOnPlay = m_currentTime = 0.0;
-    m_lastTime = m_lastTimerTime = 10000000.0;
+    m_needInitialization = true;
+    m_lastTime = 10000000.0;
+    m_positionPresetRecallPending = false;
 
     m_bpm = 120;
+    m_ppqPosition = 0.0;
+    m_quarterNotesPerBar = 4.0;
 
     m_newPositionPreset = m_currentPositionPreset = m_lastPositionPreset = 0;
 
@@ -104,14 +120,26 @@ ControlGrisAudioProcessor::ControlGrisAudioProcessor()
 
     m_lastSourceLink = m_lastSourceLinkAlt = 0;
 
+    m_linkStrategy = m_validateStrategy = m_linkAltStrategy = m_validateAltStrategy = nullptr;
+    m_strategySourceLink = m_strategySourceLinkAlt = -1;
+    m_strategyOscFormat = m_selectedOscFormat;
+
     m_canStopActivate = false;
 
+    initOscAddressHandlers();
+    rebuildOscAddressCache();
+
     // Size of the plugin window.
     parameters.state.addChild ({ "uiState", { { "width",  650 }, { "height", 700 } }, {} }, -1, nullptr);
 
     // Global setting parameters.
     parameters.state.setProperty("oscFormat", 0, nullptr);
     parameters.state.setProperty("oscPortNumber", 18032, nullptr);
+    parameters.state.setProperty("oscOutputRate", DEFAULT_OSC_OUTPUT_RATE, nullptr);
+    parameters.state.setProperty("oscBundleMode", false, nullptr);
+    parameters.state.setProperty("oscMaxDatagramSize", DEFAULT_OSC_MAX_DATAGRAM_SIZE, nullptr);
+    parameters.state.setProperty("oscKeepAliveInterval", DEFAULT_OSC_KEEP_ALIVE_INTERVAL, nullptr);
+    parameters.state.setProperty("recordingCapacity", DEFAULT_RECORDING_CAPACITY, nullptr);
     parameters.state.setProperty("oscConnected", true, nullptr);
     parameters.state.setProperty("oscInputPortNumber", 9000, nullptr);
     parameters.state.setProperty("oscInputConnected", false, nullptr);
@@ -133,49 +161,56 @@ ControlGrisAudioProcessor::ControlGrisAudioProcessor()
     parameters.state.setProperty("cycleDuration", 5, nullptr);
     parameters.state.setProperty("durationUnit", 1, nullptr);
 
-    // Per source parameters. Because there is no attachment to the automatable
-    // parameters, we need to keep track of the current parameter values to be
-    // able to reload the last state of the plugin when we close/open the UI.
+    // Per source parameters (p_azimuth_, p_elevation_, p_distance_) are only
+    // written for the active sources. Because there is no attachment to the
+    // automatable parameters, we need to keep track of the current parameter
+    // values to be able to reload the last state of the plugin when we close/open the UI.
     for (int i = 0; i < MAX_NUMBER_OF_SOURCES; i++) {
-        String id(i);
-        // Non-automatable, per source, parameters.
-        parameters.state.setProperty(String("p_azimuth_") + id, i % 2 == 0 ? -90.0 : 90.0, nullptr);
-        parameters.state.setProperty(String("p_elevation_") + id, 0.0, nullptr);
-        parameters.state.setProperty(String("p_distance_") + id, 1.0, nullptr);
-        parameters.state.setProperty(String("p_x_") + id, 0.0, nullptr);
-        parameters.state.setProperty(String("p_y_") + id, 0.0, nullptr);
-
+        sources[i].setBank(&sourceBank, i);
         // Gives the source an initial id...
         sources[i].setId(i + m_firstSourceId - 1);
         // .. and coordinates.
-        sources[i].setAzimuth(i % 2 == 0 ? 90.0 : -90.0);
-        sources[i].setElevation(0.0);
-        sources[i].setDistance(1.0);
+        sourceBank.azimuth[i] = i % 2 == 0 ? 90.0 : -90.0;
+        sourceBank.elevation[i] = sourceBank.elevationNoClip[i] = 0.0;
+        sourceBank.distance[i] = sourceBank.distanceNoClip[i] = 1.0;
     }
+    sourceBank.computeXY(0, MAX_NUMBER_OF_SOURCES);
 
     automationManager.setSourcePosition(sources[0].getPos());
     parameters.getParameter("recordingTrajectory_x")->setValue(sources[0].getPos().x);
     parameters.getParameter("recordingTrajectory_y")->setValue(sources[0].getPos().y);
 
     // Automation values for the recording trajectory.
-    parameters.addParameterListener(String("recordingTrajectory_x"), this);
-    parameters.addParameterListener(String("recordingTrajectory_y"), this);
-    parameters.addParameterListener(String("recordingTrajectory_z"), this);
-    parameters.addParameterListener(String("sourceLink"), this);
-    parameters.addParameterListener(String("sourceLinkAlt"), this);
-    parameters.addParameterListener(String("positionPreset"), this);
-    parameters.addParameterListener(String("azimuthSpan"), this);
-    parameters.addParameterListener(String("elevationSpan"), this);
+    for (int i = 0; i < kNumberOfListenedParameters; i++) {
+        deferredParameters[i].value = 0.f;
+        deferredParameters[i].pending = false;
+        parameters.addParameterListener(String(listenedParameterIds[i]), this);
+    }
 
+    automationManager.setTrajectoryManager(&trajectoryManager, TrajectoryManager::AXIS_XY);
+    automationManagerAlt.setTrajectoryManager(&trajectoryManager, TrajectoryManager::AXIS_Z);
     automationManager.addListener(this);
     automationManagerAlt.addListener(this);
 
-    // The timer's callback send OSC messages periodically.
-    //-----------------------------------------------------
-    startTimerHz(50);
+    zeromem(m_lastSentSourceVersions, sizeof(m_lastSentSourceVersions));
+    publishSourceFrames();
+
+    // OSC messages to the server are sent from their own thread.
+    oscSenderThread.startThread();
+
+    // The high resolution timer's callback send source positions to the server.
+    //--------------------------------------------------------------------------
+    setOscOutputRate(DEFAULT_OSC_OUTPUT_RATE);
+
+    // The timer's callback updates the automations and refreshes the editor.
+    //-----------------------------------------------------------------------
+    Timer::startTimerHz(50);
 }
 
 ControlGrisAudioProcessor::~ControlGrisAudioProcessor() {
+    Timer::stopTimer();
+    HighResolutionTimer::stopTimer();
+    oscSenderThread.stopThread(1000);
     disconnectOSC();
 }
 
@@ -185,6 +220,12 @@ void ControlGrisAudioProcessor::parameterChanged(const String &parameterID, floa
         return;
     }
 
+    // Sources are only modified on the message thread.
+    if (! MessageManager::existsAndIsCurrentThread()) {
+        deferParameterChange(parameterID, newValue);
+        return;
+    }
+
     bool needToLinkSourcePositions = false;
     if (parameterID.compare("recordingTrajectory_x") == 0) {
         automationManager.setPlaybackPositionX(newValue);
@@ -244,6 +285,28 @@ void ControlGrisAudioProcessor::parameterChanged(const String &parameterID, floa
     }
 }
 
+void ControlGrisAudioProcessor::deferParameterChange(const String& parameterID, float newValue) {
+    for (int i = 0; i < kNumberOfListenedParameters; i++) {
+        if (parameterID == listenedParameterIds[i]) {
+            deferredParameters[i].value = newValue;
+            deferredParameters[i].pending = true;
+            return;
+        }
+    }
+}
+
+void ControlGrisAudioProcessor::applyDeferredParameterChanges() {
+    for (int i = 0; i < kNumberOfListenedParameters; i++) {
+        if (deferredParameters[i].pending.exchange(false)) {
+            parameterChanged(String(listenedParameterIds[i]), deferredParameters[i].value);
+        }
+    }
+}
+
+void ControlGrisAudioProcessor::publishSourceFrames() {
+    sourceFrames.publish(sources, m_numOfSources);
+}
+
 //== Tools for sorting sources based on azimuth values. ==
 struct Sorter {
     int index;
@@ -387,10 +450,11 @@ void ControlGrisAudioProcessor::onSourceLinkAltChanged(int value) {
 //==============================================================================
 void ControlGrisAudioProcessor::setOscFormat(SPAT_MODE_ENUM oscFormat) {
     m_selectedOscFormat = oscFormat;
-    parameters.state.setProperty("oscFormat", m_selectedOscFormat, nullptr);
+    parameters.state.setProperty("oscFormat", oscFormat, nullptr);
     for (int i = 0; i < MAX_NUMBER_OF_SOURCES; i++) {
         sources[i].setRadiusIsElevation(m_selectedOscFormat != SPAT_MODE_LBAP);
     }
+    requestOscFullRefresh();
 }
 
 SPAT_MODE_ENUM ControlGrisAudioProcessor::getOscFormat() {
@@ -406,27 +470,78 @@ int ControlGrisAudioProcessor::getOscPortNumber() {
     return m_currentOSCPort;
 }
 
-void ControlGrisAudioProcessor::setFirstSourceId(int firstSourceId, bool propagate) {
+void ControlGrisAudioProcessor::setOscOutputRate(int rate) {
+    m_oscOutputRate = jlimit(MIN_OSC_OUTPUT_RATE, MAX_OSC_OUTPUT_RATE, rate);
+    parameters.state.setProperty("oscOutputRate", m_oscOutputRate, nullptr);
+
+    // The high resolution timer has a 1 ms resolution.
+    HighResolutionTimer::startTimer(jmax(1, roundToInt(1000.0 / m_oscOutputRate)));
+}
+
+int ControlGrisAudioProcessor::getOscOutputRate() {
+    return m_oscOutputRate;
+}
+
+void ControlGrisAudioProcessor::setOscBundleMode(bool shouldUseBundles) {
+    oscSenderThread.setBundleMode(shouldUseBundles);
+    parameters.state.setProperty("oscBundleMode", shouldUseBundles, nullptr);
+}
+
+bool ControlGrisAudioProcessor::getOscBundleMode() {
+    return oscSenderThread.getBundleMode();
+}
+
+void ControlGrisAudioProcessor::setOscMaxDatagramSize(int numBytes) {
+    oscSenderThread.setMaxDatagramSize(numBytes);
+    parameters.state.setProperty("oscMaxDatagramSize", oscSenderThread.getMaxDatagramSize(), nullptr);
+}
+
+int ControlGrisAudioProcessor::getOscMaxDatagramSize() {
+    return oscSenderThread.getMaxDatagramSize();
+}
+
+void ControlGrisAudioProcessor::setOscKeepAliveInterval(int milliseconds) {
+    m_oscKeepAliveInterval = jlimit(MIN_OSC_KEEP_ALIVE_INTERVAL, MAX_OSC_KEEP_ALIVE_INTERVAL, milliseconds);
+    parameters.state.setProperty("oscKeepAliveInterval", m_oscKeepAliveInterval.load(), nullptr);
+}
+
+int ControlGrisAudioProcessor::getOscKeepAliveInterval() {
+    return m_oscKeepAliveInterval;
+}
+
+void ControlGrisAudioProcessor::setRecordingCapacity(int numberOfPoints) {
+    numberOfPoints = jlimit(MIN_RECORDING_CAPACITY, MAX_RECORDING_CAPACITY, numberOfPoints);
+    // Changing the capacity reallocates the buffers and interrupts a drawing in progress.
+    if (numberOfPoints != automationManager.getRecordingCapacity()) {
+        automationManager.setRecordingCapacity(numberOfPoints);
+        automationManagerAlt.setRecordingCapacity(numberOfPoints);
+    }
+    parameters.state.setProperty("recordingCapacity", getRecordingCapacity(), nullptr);
+}
+
+int ControlGrisAudioProcessor::getRecordingCapacity() {
+    return automationManager.getRecordingCapacity();
+}
+
+void ControlGrisAudioProcessor::setFirstSourceId(int firstSourceId) {
     m_firstSourceId = firstSourceId;
     parameters.state.setProperty("firstSourceId", m_firstSourceId, nullptr);
     for (int i = 0; i < MAX_NUMBER_OF_SOURCES; i++) {
         sources[i].setId(i + m_firstSourceId - 1);
     }
-
-    if (propagate)
-        sendOscMessage();
+    publishSourceFrames();
+    requestOscFullRefresh();
 }
 
 int ControlGrisAudioProcessor::getFirstSourceId() {
     return m_firstSourceId;
 }
 
-void ControlGrisAudioProcessor::setNumberOfSources(int numOfSources, bool propagate) {
-    m_numOfSources = numOfSources;
+void ControlGrisAudioProcessor::setNumberOfSources(int numOfSources) {
+    m_numOfSources = jlimit(1, MAX_NUMBER_OF_SOURCES, numOfSources);
     parameters.state.setProperty("numberOfSources", m_numOfSources, nullptr);
-
-    if (propagate)
-        sendOscMessage();
+    publishSourceFrames();
+    requestOscFullRefresh();
 }
 
 void ControlGrisAudioProcessor::setSelectedSourceId(int id) {
@@ -445,18 +560,20 @@ Source * ControlGrisAudioProcessor::getSources() {
 bool ControlGrisAudioProcessor::createOscConnection(int oscPort) {
     disconnectOSC();
 
-    m_oscConnected = oscSender.connect("127.0.0.1", oscPort);
+    m_oscConnected = oscSenderThread.connect("127.0.0.1", oscPort);
     if (!m_oscConnected)
         std::cout << "Error: could not connect to UDP port " << oscPort << "." << std::endl;
     else
         m_lastConnectedOSCPort = oscPort;
 
+    requestOscFullRefresh();
+
     return m_oscConnected;
 }
 
 bool ControlGrisAudioProcessor::disconnectOSC() {
     if (m_oscConnected) {
-        if (oscSender.disconnect()) {
+        if (oscSenderThread.disconnect()) {
             m_oscConnected = false;
             m_lastConnectedOSCPort = -1;
         }
@@ -483,32 +600,62 @@ void ControlGrisAudioProcessor::sendOscMessage() {
     if (! m_oscConnected)
         return;
 
-    OSCAddressPattern oscPattern("/spat/serv");
-    OSCMessage message(oscPattern);
+    // Only the sources that have changed are sent, except for the periodic
+    // keep-alive where all sources are sent.
+    double now = Time::getMillisecondCounterHiRes();
+    bool fullRefresh = m_oscFullRefreshRequested.exchange(false);
+    if (now - m_lastOscFullRefreshTime >= m_oscKeepAliveInterval) {
+        fullRefresh = true;
+    }
+    if (fullRefresh) {
+        m_lastOscFullRefreshTime = now;
+    }
 
-    for (int i = 0; i < m_numOfSources; i++) {
-        message.clear();
-        float azim = -sources[i].getAzimuth() / 180.0 * M_PI;
-        float elev = (M_PI / 2.0) - (sources[i].getElevation() / 360.0 * M_PI * 2.0);
-        message.addInt32(sources[i].getId());
-        message.addFloat32(azim);
-        message.addFloat32(elev);
-        message.addFloat32(sources[i].getAzimuthSpan() * 2.0);
-        message.addFloat32(sources[i].getElevationSpan() * 0.5);
-        if (m_selectedOscFormat == SPAT_MODE_LBAP) {
-            message.addFloat32(sources[i].getDistance() / 0.6);
-        } else {
-            message.addFloat32(sources[i].getDistance());
+    int numberOfSources = sourceFrames.read(oscOutputFrames);
+    const bool isLbap = m_selectedOscFormat == SPAT_MODE_LBAP;
+
+    SpatServFrame frame;
+    bool hasPushedFrames = false;
+    for (int i = 0; i < numberOfSources; i++) {
+        const SourceFrame& source = oscOutputFrames[i];
+        if (source.version == m_lastSentSourceVersions[i] && ! fullRefresh) {
+            continue;
         }
-        message.addFloat32(0.0);
+        m_lastSentSourceVersions[i] = source.version;
 
-        if (!oscSender.send(message)) {
-            //std::cout << "Error: could not send OSC message." << std::endl;
-            return;
+        frame.sourceId = source.id;
+        frame.azimuth = -source.azimuth / 180.0 * M_PI;
+        frame.elevation = (M_PI / 2.0) - (source.elevation / 360.0 * M_PI * 2.0);
+        frame.azimuthSpan = source.azimuthSpan * 2.0;
+        frame.elevationSpan = source.elevationSpan * 0.5;
+        if (isLbap) {
+            frame.distance = source.distance / 0.6;
+        } else {
+            frame.distance = source.distance;
         }
+        oscSenderThread.pushFrame(frame);
+        hasPushedFrames = true;
+    }
+
+    // The sender thread is woken once per tick, so that in bundle mode all the
+    // changed sources go in the same bundle.
+    if (hasPushedFrames) {
+        oscSenderThread.flush();
     }
 }
 
+void ControlGrisAudioProcessor::requestOscFullRefresh() {
+    m_oscFullRefreshRequested = true;
+}
+
+int ControlGrisAudioProcessor::getOscQueueDepth() const {
+    return oscSenderThread.getQueueDepth();
+}
+
+int ControlGrisAudioProcessor::getOscDroppedFrameCount() const {
+    return oscSenderThread.getDroppedFrameCount();
+}
+
 //==============================================================================
 bool ControlGrisAudioProcessor::createOscInputConnection(int oscPort) {
     disconnectOSCInput(oscPort);
@@ -553,82 +700,170 @@ void ControlGrisAudioProcessor::oscBundleReceived(const OSCBundle& bundle) {
     }
 }
 
-void ControlGrisAudioProcessor::oscMessageReceived(const OSCMessage& message) {
-    int sourceLinkToProcess = 0, sourceLinkAltToProcess = 0;
-    float x = -1.f, y = -1.f, z = -1.f;
-    String address = message.getAddressPattern().toString().toStdString();
-    String pluginInstance = String("/controlgris/") + String(getOscOutputPluginId());
-    if ((address == String(pluginInstance + "/traj/1/x") || address == String(pluginInstance + "/traj/1/xyz/1")) &&
-         automationManager.getDrawingType() == TRAJECTORY_TYPE_REALTIME) {
-        x = message[0].getFloat32();
-    } else if ((address == String(pluginInstance + "/traj/1/y") || address == String(pluginInstance + "/traj/1/xyz/2")) &&
-                automationManager.getDrawingType() == TRAJECTORY_TYPE_REALTIME) {
-        y = message[0].getFloat32();
-    } else if ((address == String(pluginInstance + "/traj/1/z") || address == String(pluginInstance + "/traj/1/xyz/3")) &&
-                automationManagerAlt.getDrawingType() == TRAJECTORY_TYPE_ALT_REALTIME) {
-        z = message[0].getFloat32();
-    } else if (address == String(pluginInstance + "/traj/1/xy") && automationManager.getDrawingType() == TRAJECTORY_TYPE_REALTIME) {
-        x = message[0].getFloat32();
-        y = message[1].getFloat32();
-    } else if (address == String(pluginInstance + "/traj/1/xyz")) {
+void ControlGrisAudioProcessor::initOscAddressHandlers() {
+    oscAddressHandlers[OSC_ADDRESS_TRAJ_X] = oscAddressHandlers[OSC_ADDRESS_TRAJ_XYZ_1] = [this] (const OSCMessage& message) {
+        if (automationManager.getDrawingType() == TRAJECTORY_TYPE_REALTIME) {
+            float x = message[0].getFloat32();
+            storeOscPosition(&x, nullptr, nullptr);
+        }
+    };
+    oscAddressHandlers[OSC_ADDRESS_TRAJ_Y] = oscAddressHandlers[OSC_ADDRESS_TRAJ_XYZ_2] = [this] (const OSCMessage& message) {
         if (automationManager.getDrawingType() == TRAJECTORY_TYPE_REALTIME) {
-            x = message[0].getFloat32();
-            y = message[1].getFloat32();
+            float y = message[0].getFloat32();
+            storeOscPosition(nullptr, &y, nullptr);
         }
+    };
+    oscAddressHandlers[OSC_ADDRESS_TRAJ_Z] = oscAddressHandlers[OSC_ADDRESS_TRAJ_XYZ_3] = [this] (const OSCMessage& message) {
         if (automationManagerAlt.getDrawingType() == TRAJECTORY_TYPE_ALT_REALTIME) {
-            z = message[2].getFloat32();
+            float z = message[0].getFloat32();
+            storeOscPosition(nullptr, nullptr, &z);
         }
-    } else if (address == String(pluginInstance + "/azispan")) {
+    };
+    oscAddressHandlers[OSC_ADDRESS_TRAJ_XY] = [this] (const OSCMessage& message) {
+        if (automationManager.getDrawingType() == TRAJECTORY_TYPE_REALTIME) {
+            float x = message[0].getFloat32(), y = message[1].getFloat32();
+            storeOscPosition(&x, &y, nullptr);
+        }
+    };
+    oscAddressHandlers[OSC_ADDRESS_TRAJ_XYZ] = [this] (const OSCMessage& message) {
+        bool isXYRealtime = automationManager.getDrawingType() == TRAJECTORY_TYPE_REALTIME;
+        bool isZRealtime = automationManagerAlt.getDrawingType() == TRAJECTORY_TYPE_ALT_REALTIME;
+        float x = message[0].getFloat32(), y = message[1].getFloat32(), z = message[2].getFloat32();
+        storeOscPosition(isXYRealtime ? &x : nullptr, isXYRealtime ? &y : nullptr, isZRealtime ? &z : nullptr);
+    };
+    oscAddressHandlers[OSC_ADDRESS_AZISPAN] = [this] (const OSCMessage& message) {
+        storeOscControlValue(OSC_CONTROL_AZISPAN, message[0].getFloat32());
+    };
+    oscAddressHandlers[OSC_ADDRESS_ELESPAN] = [this] (const OSCMessage& message) {
+        storeOscControlValue(OSC_CONTROL_ELESPAN, message[0].getFloat32());
+    };
+    oscAddressHandlers[OSC_ADDRESS_SOURCE_LINK] = [this] (const OSCMessage& message) {
+        storeOscControlValue(OSC_CONTROL_SOURCE_LINK, (int)message[0].getFloat32()); // 1 -> 6
+    };
+    for (int i = 1; i <= 6; i++) {
+        oscAddressHandlers[OSC_ADDRESS_SOURCE_LINK_1 + i - 1] = [this, i] (const OSCMessage& message) {
+            if (message[0].getFloat32() == 1)
+                storeOscControlValue(OSC_CONTROL_SOURCE_LINK, i);
+        };
+    }
+    oscAddressHandlers[OSC_ADDRESS_SOURCE_LINK_ALT] = [this] (const OSCMessage& message) {
+        storeOscControlValue(OSC_CONTROL_SOURCE_LINK_ALT, (int)message[0].getFloat32()); // 1 -> 5
+    };
+    for (int i = 1; i <= 5; i++) {
+        oscAddressHandlers[OSC_ADDRESS_SOURCE_LINK_ALT_1 + i - 1] = [this, i] (const OSCMessage& message) {
+            if (message[0].getFloat32() == 1)
+                storeOscControlValue(OSC_CONTROL_SOURCE_LINK_ALT, i);
+        };
+    }
+    oscAddressHandlers[OSC_ADDRESS_PRESETS] = [this] (const OSCMessage& message) {
+        storeOscControlValue(OSC_CONTROL_PRESET, (int)message[0].getFloat32()); // 1 -> 50
+    };
+
+    for (int i = 0; i < OSC_ADDRESS_NUMBER_OF_ADDRESSES; i++) {
+        oscAddressHitCounts[i] = 0;
+    }
+    oscUnknownAddressCount = 0;
+
+    for (int i = 0; i < OSC_CONTROL_NUMBER_OF_SLOTS; i++) {
+        oscControlSlots[i].value = 0.f;
+        oscControlSlots[i].pending = false;
+    }
+    oscPosition = { 0.f, 0.f, 0.f, false, false, false };
+    oscControlDroppedCount = 0;
+}
+
+void ControlGrisAudioProcessor::storeOscControlValue(int slot, float value) {
+    oscControlSlots[slot].value = value;
+    // A value still pending is replaced by the new one.
+    if (oscControlSlots[slot].pending.exchange(true)) {
+        oscControlDroppedCount++;
+    }
+}
+
+bool ControlGrisAudioProcessor::takeOscControlValue(int slot, float& value) {
+    if (! oscControlSlots[slot].pending.exchange(false)) {
+        return false;
+    }
+    value = oscControlSlots[slot].value;
+    return true;
+}
+
+// Null coordinates are left as they are.
+void ControlGrisAudioProcessor::storeOscPosition(const float* x, const float* y, const float* z) {
+    const SpinLock::ScopedLockType lock (oscPositionLock);
+    bool replaced = false;
+    if (x != nullptr) {
+        replaced |= oscPosition.hasX;
+        oscPosition.x = *x;
+        oscPosition.hasX = true;
+    }
+    if (y != nullptr) {
+        replaced |= oscPosition.hasY;
+        oscPosition.y = *y;
+        oscPosition.hasY = true;
+    }
+    if (z != nullptr) {
+        replaced |= oscPosition.hasZ;
+        oscPosition.z = *z;
+        oscPosition.hasZ = true;
+    }
+    if (replaced) {
+        oscControlDroppedCount++;
+    }
+}
+
+int ControlGrisAudioProcessor::getOscControlDroppedCount() const {
+    return oscControlDroppedCount;
+}
+
+int ControlGrisAudioProcessor::getOscAddressHitCount(int address) const {
+    return oscAddressHitCounts[address];
+}
+
+int ControlGrisAudioProcessor::getOscUnknownAddressCount() const {
+    return oscUnknownAddressCount;
+}
+
+void ControlGrisAudioProcessor::oscMessageReceived(const OSCMessage& message) {
+    int address = findOscAddress(message.getAddressPattern().toString());
+    if (address < 0 || ! oscAddressHandlers[address]) {
+        oscUnknownAddressCount++;
+        return;
+    }
+
+    oscAddressHitCounts[address]++;
+    oscAddressHandlers[address](message);
+}
+
+// Applies the latest controller values received since the last timer tick.
+void ControlGrisAudioProcessor::applyOscControlValues() {
+    PendingPosition position;
+    {
+        const SpinLock::ScopedLockType lock (oscPositionLock);
+        position = oscPosition;
+        oscPosition.hasX = oscPosition.hasY = oscPosition.hasZ = false;
+    }
+    float x = position.x, y = position.y, z = position.z, value;
+    bool hasX = position.hasX, hasY = position.hasY, hasZ = position.hasZ;
+
+    if (takeOscControlValue(OSC_CONTROL_AZISPAN, value)) {
         for (int i = 0; i < m_numOfSources; i++)
-            sources[i].setAzimuthSpan(message[0].getFloat32());
+            sources[i].setAzimuthSpan(value);
         parameters.getParameter("azimuthSpan")->beginChangeGesture();
-        parameters.getParameter("azimuthSpan")->setValueNotifyingHost(message[0].getFloat32());
+        parameters.getParameter("azimuthSpan")->setValueNotifyingHost(value);
         parameters.getParameter("azimuthSpan")->endChangeGesture();
-    } else if (address == String(pluginInstance + "/elespan")) {
-            for (int i = 0; i < m_numOfSources; i++)
-                sources[i].setElevationSpan(message[0].getFloat32());
-            parameters.getParameter("elevationSpan")->beginChangeGesture();
-            parameters.getParameter("elevationSpan")->setValueNotifyingHost(message[0].getFloat32());
-            parameters.getParameter("elevationSpan")->endChangeGesture();
-    } else if (address == String(pluginInstance + "/sourcelink/1/1")) {
-        if (message[0].getFloat32() == 1)
-            sourceLinkToProcess = 1;
-    } else if (address == String(pluginInstance + "/sourcelink/2/1")) {
-        if (message[0].getFloat32() == 1)
-            sourceLinkToProcess = 2;
-    } else if (address == String(pluginInstance + "/sourcelink/3/1")) {
-        if (message[0].getFloat32() == 1)
-            sourceLinkToProcess = 3;
-    } else if (address == String(pluginInstance + "/sourcelink/4/1")) {
-        if (message[0].getFloat32() == 1)
-            sourceLinkToProcess = 4;
-    } else if (address == String(pluginInstance + "/sourcelink/5/1")) {
-        if (message[0].getFloat32() == 1)
-            sourceLinkToProcess = 5;
-    } else if (address == String(pluginInstance + "/sourcelink/6/1")) {
-        if (message[0].getFloat32() == 1)
-            sourceLinkToProcess = 6;
-    } else if (address == String(pluginInstance + "/sourcelink")) {
-        sourceLinkToProcess = (int)message[0].getFloat32(); // 1 -> 6
-    } else if (address == String(pluginInstance + "/sourcelinkalt/1/1")) {
-        if (message[0].getFloat32() == 1)
-            sourceLinkAltToProcess = 1;
-    } else if (address == String(pluginInstance + "/sourcelinkalt/2/1")) {
-        if (message[0].getFloat32() == 1)
-            sourceLinkAltToProcess = 2;
-    } else if (address == String(pluginInstance + "/sourcelinkalt/3/1")) {
-        if (message[0].getFloat32() == 1)
-            sourceLinkAltToProcess = 3;
-    } else if (address == String(pluginInstance + "/sourcelinkalt/4/1")) {
-        if (message[0].getFloat32() == 1)
-            sourceLinkAltToProcess = 4;
-    } else if (address == String(pluginInstance + "/sourcelinkalt/5/1")) {
-        if (message[0].getFloat32() == 1)
-            sourceLinkAltToProcess = 5;
-    } else if (address == String(pluginInstance + "/sourcelinkalt")) {
-        sourceLinkAltToProcess = (int)message[0].getFloat32(); // 1 -> 5
-    } else if (address == String(pluginInstance + "/presets")) {
-        int newPreset = (int)message[0].getFloat32(); // 1 -> 50
+    }
+
+    if (takeOscControlValue(OSC_CONTROL_ELESPAN, value)) {
+        for (int i = 0; i < m_numOfSources; i++)
+            sources[i].setElevationSpan(value);
+        parameters.getParameter("elevationSpan")->beginChangeGesture();
+        parameters.getParameter("elevationSpan")->setValueNotifyingHost(value);
+        parameters.getParameter("elevationSpan")->endChangeGesture();
+    }
+
+    if (takeOscControlValue(OSC_CONTROL_PRESET, value)) {
+        int newPreset = (int)value;
         setPositionPreset(newPreset);
         ControlGrisAudioProcessorEditor *ed = dynamic_cast<ControlGrisAudioProcessorEditor *>(getActiveEditor());
         if (ed != nullptr) {
@@ -636,7 +871,7 @@ void ControlGrisAudioProcessor::oscMessageReceived(const OSCMessage& message) {
         }
     }
 
-    if (x != -1.f && y != -1.f) {
+    if (hasX && hasY) {
         if (automationManager.getSourceLink() == SOURCE_LINK_DELTA_LOCK) {
             automationManager.setSourcePositionX(x);
             automationManager.setSourcePositionY(y);
@@ -647,7 +882,7 @@ void ControlGrisAudioProcessor::oscMessageReceived(const OSCMessage& message) {
             sourcePositionChanged(0, 0);
         }
         setPositionPreset(0);
-    } else if (y != -1.f) {
+    } else if (hasY) {
         if (automationManager.getSourceLink() == SOURCE_LINK_DELTA_LOCK) {
             automationManager.setSourcePositionY(y);
             automationManager.sendTrajectoryPositionChangedEvent();
@@ -656,7 +891,7 @@ void ControlGrisAudioProcessor::oscMessageReceived(const OSCMessage& message) {
             sourcePositionChanged(0, 0);
         }
         setPositionPreset(0);
-    } else if (x != -1.f) {
+    } else if (hasX) {
         if (automationManager.getSourceLink() == SOURCE_LINK_DELTA_LOCK) {
             automationManager.setSourcePositionX(x);
             automationManager.sendTrajectoryPositionChangedEvent();
@@ -667,17 +902,17 @@ void ControlGrisAudioProcessor::oscMessageReceived(const OSCMessage& message) {
         setPositionPreset(0);
     }
 
-    if (z != -1.f) {
+    if (hasZ) {
         automationManagerAlt.setSourcePositionY(z);
         automationManagerAlt.sendTrajectoryPositionChangedEvent();
         setPositionPreset(0);
     }
 
-    if (sourceLinkToProcess)
-        setSourceLink(sourceLinkToProcess);
+    if (takeOscControlValue(OSC_CONTROL_SOURCE_LINK, value) && (int)value != 0)
+        setSourceLink((int)value);
 
-    if (sourceLinkAltToProcess)
-        setSourceLinkAlt(sourceLinkAltToProcess);
+    if (takeOscControlValue(OSC_CONTROL_SOURCE_LINK_ALT, value) && (int)value != 0)
+        setSourceLinkAlt((int)value);
 }
 
 //==============================================================================
@@ -719,68 +954,96 @@ bool ControlGrisAudioProcessor::getOscOutputConnected() {
 
 void ControlGrisAudioProcessor::setOscOutputPluginId(int pluginId) {
     parameters.state.setProperty("oscOutputPluginId", pluginId, nullptr);
+    if (pluginId != m_oscOutputPluginId) {
+        m_oscOutputPluginId = pluginId;
+        rebuildOscAddressCache();
+    }
 }
 
 int ControlGrisAudioProcessor::getOscOutputPluginId() {
-    return parameters.state.getProperty("oscOutputPluginId", 1);
+    return m_oscOutputPluginId;
+}
+
+void ControlGrisAudioProcessor::rebuildOscAddressCache() {
+    String pluginInstance = String("/controlgris/") + String(m_oscOutputPluginId);
+
+    Array<OSCAddressPattern> patterns;
+    HashMap<String, int> addresses;
+    for (int i = 0; i < OSC_ADDRESS_NUMBER_OF_ADDRESSES; i++) {
+        String address = pluginInstance + OSC_ADDRESS_SUFFIXES[i];
+        patterns.add(OSCAddressPattern (address));
+        addresses.set(address, i);
+    }
+
+    const SpinLock::ScopedLockType lock (oscAddressLock);
+    oscAddressPatterns.swapWith(patterns);
+    oscAddressMap.swapWith(addresses);
+    oscAddressPrefix = pluginInstance + "/";
+}
+
+int ControlGrisAudioProcessor::findOscAddress(const String& address) {
+    const SpinLock::ScopedLockType lock (oscAddressLock);
+    // Messages for other instances are rejected before hashing the address.
+    if (! address.startsWith(oscAddressPrefix)) {
+        return -1;
+    }
+    return oscAddressMap.contains(address) ? oscAddressMap[address] : -1;
 }
 
 void ControlGrisAudioProcessor::sendOscOutputMessage() {
     if (! m_oscOutputConnected)
         return;
 
-    OSCMessage message(OSCAddressPattern ("/tmp"));
-
-    String pluginInstance = String("/controlgris/") + String(getOscOutputPluginId());
+    OSCMessage message(oscAddressPatterns.getReference(OSC_ADDRESS_TRAJ_X));
 
     float trajectory1x = automationManager.getSourcePosition().x;
     float trajectory1y = automationManager.getSourcePosition().y;
     float trajectory1z = automationManagerAlt.getSourcePosition().y;
 
     if (m_lastTrajectory1x != trajectory1x) {
-        message.setAddressPattern(OSCAddressPattern (pluginInstance + "/traj/1/x"));
+        message.setAddressPattern(oscAddressPatterns.getReference(OSC_ADDRESS_TRAJ_X));
         message.addFloat32(trajectory1x);
         oscOutputSender.send(message);
         message.clear();
 
-        message.setAddressPattern(OSCAddressPattern (pluginInstance + "/traj/1/xyz/1"));
+        message.setAddressPattern(oscAddressPatterns.getReference(OSC_ADDRESS_TRAJ_XYZ_1));
         message.addFloat32(trajectory1x);
         oscOutputSender.send(message);
         message.clear();
     }
 
     if (m_lastTrajectory1y != trajectory1y) {
-        message.setAddressPattern(OSCAddressPattern (pluginInstance + "/traj/1/y"));
+        message.setAddressPattern(oscAddressPatterns.getReference(OSC_ADDRESS_TRAJ_Y));
         message.addFloat32(trajectory1y);
         oscOutputSender.send(message);
         message.clear();
 
-        message.setAddressPattern(OSCAddressPattern (pluginInstance + "/traj/1/xyz/2"));
+        message.setAddressPattern(oscAddressPatterns.getReference(OSC_ADDRESS_TRAJ_XYZ_2));
         message.addFloat32(trajectory1y);
         oscOutputSender.send(message);
         message.clear();
     }
 
     if (m_lastTrajectory1z != trajectory1z) {
-        message.setAddressPattern(OSCAddressPattern (pluginInstance + "/traj/1/z"));
+        message.setAddressPattern(oscAddressPatterns.getReference(OSC_ADDRESS_TRAJ_Z));
         message.addFloat32(trajectory1z);
         oscOutputSender.send(message);
         message.clear();
 
-        message.setAddressPattern(OSCAddressPattern (pluginInstance + "/traj/1/xyz/3"));
+        message.setAddressPattern(oscAddressPatterns.getReference(OSC_ADDRESS_TRAJ_XYZ_3));
         message.addFloat32(trajectory1z);
         oscOutputSender.send(message);
         message.clear();
     }
 
     if (m_lastTrajectory1x != trajectory1x || m_lastTrajectory1y != trajectory1y || m_lastTrajectory1z != trajectory1z) {
-        message.setAddressPattern(OSCAddressPattern (pluginInstance + "/traj/1/xy"));
+        message.setAddressPattern(oscAddressPatterns.getReference(OSC_ADDRESS_TRAJ_XY));
         message.addFloat32(trajectory1x);
         message.addFloat32(trajectory1y);
         oscOutputSender.send(message);
         message.clear();
 
-        message.setAddressPattern(OSCAddressPattern (pluginInstance + "/traj/1/xyz"));
+        message.setAddressPattern(oscAddressPatterns.getReference(OSC_ADDRESS_TRAJ_XYZ));
         message.addFloat32(trajectory1x);
         message.addFloat32(trajectory1y);
         message.addFloat32(trajectory1z);
@@ -793,7 +1056,7 @@ void ControlGrisAudioProcessor::sendOscOutputMessage() {
     m_lastTrajectory1z = trajectory1z;
 
     if (m_lastAzispan != sources[0].getAzimuthSpan()) {
-        message.setAddressPattern(OSCAddressPattern (pluginInstance + "/azispan"));
+        message.setAddressPattern(oscAddressPatterns.getReference(OSC_ADDRESS_AZISPAN));
         message.addFloat32(sources[0].getAzimuthSpan());
         oscOutputSender.send(message);
         message.clear();
@@ -801,7 +1064,7 @@ void ControlGrisAudioProcessor::sendOscOutputMessage() {
     }
 
     if (m_lastElespan != sources[0].getElevationSpan()) {
-        message.setAddressPattern(OSCAddressPattern (pluginInstance + "/elespan"));
+        message.setAddressPattern(oscAddressPatterns.getReference(OSC_ADDRESS_ELESPAN));
         message.addFloat32(sources[0].getElevationSpan());
         oscOutputSender.send(message);
         message.clear();
@@ -809,13 +1072,12 @@ void ControlGrisAudioProcessor::sendOscOutputMessage() {
     }
 
     if (automationManager.getSourceLink() != m_lastSourceLink) {
-        message.setAddressPattern(OSCAddressPattern (pluginInstance + "/sourcelink"));
+        message.setAddressPattern(oscAddressPatterns.getReference(OSC_ADDRESS_SOURCE_LINK));
         message.addInt32(automationManager.getSourceLink());
         oscOutputSender.send(message);
         message.clear();
 
-        String pattern = pluginInstance + String("/sourcelink/") + String(automationManager.getSourceLink()) + String("/1");
-        message.setAddressPattern(OSCAddressPattern (pattern));
+        message.setAddressPattern(oscAddressPatterns.getReference(OSC_ADDRESS_SOURCE_LINK_1 + automationManager.getSourceLink() - 1));
         message.addInt32(1);
         oscOutputSender.send(message);
         message.clear();
@@ -825,13 +1087,12 @@ void ControlGrisAudioProcessor::sendOscOutputMessage() {
 
     if (automationManagerAlt.getSourceLink() != m_lastSourceLinkAlt) {
 
-        message.setAddressPattern(OSCAddressPattern (pluginInstance + "/sourcelinkalt"));
+        message.setAddressPattern(oscAddressPatterns.getReference(OSC_ADDRESS_SOURCE_LINK_ALT));
         message.addInt32(automationManagerAlt.getSourceLink());
         oscOutputSender.send(message);
         message.clear();
 
-        String patternAlt = pluginInstance + String("/sourcelinkalt/") + String(automationManagerAlt.getSourceLink()) + String("/1");
-        message.setAddressPattern(OSCAddressPattern (patternAlt));
+        message.setAddressPattern(oscAddressPatterns.getReference(OSC_ADDRESS_SOURCE_LINK_ALT_1 + automationManagerAlt.getSourceLink() - 1));
         message.addInt32(1);
         oscOutputSender.send(message);
         message.clear();
@@ -840,7 +1101,7 @@ void ControlGrisAudioProcessor::sendOscOutputMessage() {
     }
 
     if (m_currentPositionPreset != m_lastPositionPreset) {
-        message.setAddressPattern(OSCAddressPattern (pluginInstance + "/presets"));
+        message.setAddressPattern(oscAddressPatterns.getReference(OSC_ADDRESS_PRESETS));
         message.addInt32(m_currentPositionPreset);
         oscOutputSender.send(message);
         message.clear();
@@ -851,6 +1112,18 @@ void ControlGrisAudioProcessor::sendOscOutputMessage() {
 
 //==============================================================================
 void ControlGrisAudioProcessor::timerCallback() {
+    applyDeferredParameterChanges();
+    applyOscControlValues();
+
+    if (m_positionPresetRecallPending.exchange(false) && m_currentPositionPreset != 0) {
+        if (recallFixedPosition(m_currentPositionPreset)) {
+            ControlGrisAudioProcessorEditor *ed = dynamic_cast<ControlGrisAudioProcessorEditor *>(getActiveEditor());
+            if (ed != nullptr) {
+                ed->updatePositionPreset(m_currentPositionPreset);
+            }
+        }
+    }
+
     if (m_newPositionPreset != 0 && m_newPositionPreset != m_currentPositionPreset) {
         if (recallFixedPosition(m_newPositionPreset)) {
             m_currentPositionPreset = m_newPositionPreset;
@@ -861,12 +1134,13 @@ void ControlGrisAudioProcessor::timerCallback() {
         }
     }
 
+    // Trajectory positions are computed in processBlock, we only apply them here.
+    trajectoryManager.updateSamples();
+
     // MainField automation.
     if (automationManager.getActivateState()) {
-        if (automationManager.getDrawingType() == TRAJECTORY_TYPE_REALTIME) {
-            //...
-        } else if (m_lastTimerTime != getCurrentTime()) {
-            automationManager.setTrajectoryDeltaTime(getCurrentTime() - getInitTimeOnPlay());
+        if (automationManager.getDrawingType() != TRAJECTORY_TYPE_REALTIME) {
+            automationManager.applyTrajectoryPosition();
         }
     } else if (m_isPlaying && automationManager.hasValidPlaybackPosition()) {
         automationManager.setSourcePosition(automationManager.getPlaybackPosition());
@@ -880,10 +1154,8 @@ void ControlGrisAudioProcessor::timerCallback() {
 
     // ElevationField automation.
     if (getOscFormat() == SPAT_MODE_LBAP && automationManagerAlt.getActivateState()) {
-        if (automationManagerAlt.getDrawingType() == TRAJECTORY_TYPE_ALT_REALTIME) {
-            //...
-        } else if (m_lastTimerTime != getCurrentTime()) {
-            automationManagerAlt.setTrajectoryDeltaTime(getCurrentTime() - getInitTimeOnPlay());
+        if (automationManagerAlt.getDrawingType() != TRAJECTORY_TYPE_ALT_REALTIME) {
+            automationManagerAlt.applyTrajectoryPosition();
         }
     } else if (m_isPlaying && automationManagerAlt.hasValidPlaybackPosition()) {
         automationManagerAlt.setSourcePosition(automationManagerAlt.getPlaybackPosition());
@@ -895,7 +1167,11 @@ void ControlGrisAudioProcessor::timerCallback() {
         linkSourcePositionsAlt();
     }
 
-    m_lastTimerTime = getCurrentTime();
+    // Sources with their own trajectory are moved after the link modes, in a single pass.
+    // Like the linked sources, they are written to the bank directly: there is no host
+    // parameter per source, and the moves are replayed from the host clock and the saved
+    // trajectory instead of being recorded as automation.
+    sourceTrajectories.applyPositions(sourceBank, m_numOfSources);
 
     ControlGrisAudioProcessorEditor *editor = dynamic_cast<ControlGrisAudioProcessorEditor *>(getActiveEditor());
 
@@ -914,31 +1190,60 @@ void ControlGrisAudioProcessor::timerCallback() {
         editor->refresh();
     }
 
-    sendOscMessage();
+    publishSourceFrames();
+
     sendOscOutputMessage();
 }
 
+void ControlGrisAudioProcessor::hiResTimerCallback() {
+    sendOscMessage();
+}
+
 //==============================================================================
 void ControlGrisAudioProcessor::setPluginState() {
     // If no preset is loaded, try to restore the last saved positions.
     if (m_currentPositionPreset == 0) {
         for (int i = 0; i < m_numOfSources; i++) {
             String id(i);
-            sources[i].setNormalizedAzimuth(parameters.state.getProperty(String("p_azimuth_") + id));
-            sources[i].setNormalizedElevation(parameters.state.getProperty(String("p_elevation_") + id));
-            sources[i].setDistance(parameters.state.getProperty(String("p_distance_") + id));
+            sources[i].setNormalizedAzimuth(parameters.state.getProperty(String("p_azimuth_") + id, sources[i].getNormalizedAzimuth()));
+            sources[i].setNormalizedElevation(parameters.state.getProperty(String("p_elevation_") + id, sources[i].getNormalizedElevation()));
+            sources[i].setDistance(parameters.state.getProperty(String("p_distance_") + id, sources[i].getDistance()));
             if (i == 0) {
                 automationManager.setSourcePosition(sources[0].getPos());
             }
         }
     }
 
+    // Playback settings of the trajectory, also needed when the editor is closed.
+    trajectoryManager.setPlaybackDuration(parameters.state.getProperty("cycleDuration", 5.0),
+                                          parameters.state.getProperty("durationUnit", DURATION_UNIT_SECONDS));
+    trajectoryManager.setBackAndForth(parameters.state.getProperty("backAndForth", false));
+    trajectoryManager.setDampeningCycles(parameters.state.getProperty("dampeningCycles", 0));
+    trajectoryManager.setDeviationPerCycle(parameters.state.getProperty("deviationPerCycle", 0));
+    trajectoryManager.setConstantSpeed(parameters.state.getProperty("constantSpeed", false));
+    trajectoryManager.setRecordedTiming(parameters.state.getProperty("recordedTiming", false));
+
+    for (int i = 0; i < m_numOfSources; i++) {
+        String id(i);
+        int drawingType = parameters.state.getProperty(String("p_trajectory_type_") + id, 0);
+        if (drawingType >= TRAJECTORY_TYPE_CIRCLE_CLOCKWISE) {
+            Point<float> startPosition (parameters.state.getProperty(String("p_trajectory_x_") + id, 0.5f),
+                                        parameters.state.getProperty(String("p_trajectory_y_") + id, 0.5f));
+            setSourceTrajectory(i, drawingType, startPosition,
+                                parameters.state.getProperty(String("p_trajectory_period_") + id, 5.0),
+                                parameters.state.getProperty(String("p_trajectory_phase_") + id, 0.0));
+        } else {
+            sourceTrajectories.clearTrajectory(i);
+        }
+    }
+
     ControlGrisAudioProcessorEditor *editor = dynamic_cast<ControlGrisAudioProcessorEditor *>(getActiveEditor());
     if (editor != nullptr) {
         editor->setPluginState();
     }
 
-    sendOscMessage();
+    publishSourceFrames();
+    requestOscFullRefresh();
 }
 
 //==============================================================================
@@ -988,6 +1293,8 @@ void ControlGrisAudioProcessor::sourcePositionChanged(int sourceId, int whichFie
         }
         validateSourcePositionsAlt();
     }
+
+    publishSourceFrames();
 }
 
 // Called whenever a source has changed.
@@ -1058,141 +1365,176 @@ void ControlGrisAudioProcessor::trajectoryPositionChanged(AutomationManager *man
     }
 }
 
-void ControlGrisAudioProcessor::linkSourcePositions() {
-    float deltaX = 0.f, deltaY = 0.f;
-    switch (automationManager.getSourceLink()) {
-        case SOURCE_LINK_INDEPENDENT:
-            sources[0].setPos(automationManager.getSourcePosition());
-            break;
-        case SOURCE_LINK_CIRCULAR:
-        case SOURCE_LINK_CIRCULAR_FIXED_RADIUS:
-        case SOURCE_LINK_CIRCULAR_FIXED_ANGLE:
-        case SOURCE_LINK_CIRCULAR_FULLY_FIXED:
-            sources[0].setPos(automationManager.getSourcePosition());
-            if (getOscFormat() == SPAT_MODE_LBAP) {
-                float deltaAzimuth = sources[0].getDeltaAzimuth();
-                float deltaDistance = sources[0].getDeltaDistance();
-                for (int i = 1; i < m_numOfSources; i++) {
-                    sources[i].setCoordinatesFromFixedSource(deltaAzimuth, 0.0, deltaDistance);
-                }
-            } else {
-                float deltaAzimuth = sources[0].getDeltaAzimuth();
-                float deltaElevation = sources[0].getDeltaElevation();
-                for (int i = 1; i < m_numOfSources; i++) {
-                    sources[i].setCoordinatesFromFixedSource(deltaAzimuth, deltaElevation, 0.0);
-                }
-            }
-            break;
-        case SOURCE_LINK_DELTA_LOCK:
-            deltaX = automationManager.getSource().getDeltaX();
-            deltaY = automationManager.getSource().getDeltaY();
-            for (int i = 0; i < m_numOfSources; i++) {
-                sources[i].setXYCoordinatesFromFixedSource(deltaX, deltaY);
-            }
-            break;
-        case SOURCE_LINK_SYMMETRIC_X:
-            sources[0].setPos(automationManager.getSourcePosition());
-            if (m_numOfSources == 2)
-                sources[1].setSymmetricX(sources[0].getX(), sources[0].getY());
-            break;
-        case SOURCE_LINK_SYMMETRIC_Y:
-            sources[0].setPos(automationManager.getSourcePosition());
-            if (m_numOfSources == 2)
-                sources[1].setSymmetricY(sources[0].getX(), sources[0].getY());
-            break;
+//==============================================================================
+// Source link strategies. Each link mode (and spat mode for the main link) has
+// its own instantiation, the conditions on the template arguments are resolved
+// at compile time.
+template <int sourceLink, bool isLbap>
+void ControlGrisAudioProcessor::linkSourcePositionsWith() {
+    if (sourceLink < SOURCE_LINK_INDEPENDENT || sourceLink > SOURCE_LINK_SYMMETRIC_Y) {
+        return;
     }
-}
-
-void ControlGrisAudioProcessor::linkSourcePositionsAlt() {
-    float deltaY = 0.0f;
 
-    switch (automationManagerAlt.getSourceLink()) {
-        case SOURCE_LINK_ALT_INDEPENDENT:
-            sources[0].setNormalizedElevation(automationManagerAlt.getSourcePosition().y);
-            break;
-        case SOURCE_LINK_ALT_FIXED_ELEVATION:
-            for (int i = 0; i < m_numOfSources; i++) {
-                sources[i].setNormalizedElevation(automationManagerAlt.getSourcePosition().y);
-            }
-            break;
-        case SOURCE_LINK_ALT_LINEAR_MIN:
-            for (int i = 0; i < m_numOfSources; i++) {
-                float offset = automationManagerAlt.getSourcePosition().y * 90.0;
-                sources[i].setElevation(60.0 / m_numOfSources * i + offset);
-            }
-            break;
-        case SOURCE_LINK_ALT_LINEAR_MAX:
-            for (int i = 0; i < m_numOfSources; i++) {
-                float offset = 90.0 - automationManagerAlt.getSourcePosition().y * 90.0;
-                sources[i].setElevation(90.0 - (60.0 / m_numOfSources * i) - offset);
-            }
-            break;
-        case SOURCE_LINK_ALT_DELTA_LOCK:
-            deltaY = automationManagerAlt.getSource().getDeltaY();
-            for (int i = 0; i < m_numOfSources; i++) {
-                sources[i].setElevationFromFixedSource(deltaY);
-            }
-            break;
+    if (sourceLink == SOURCE_LINK_DELTA_LOCK) {
+        Source& source = automationManager.getSource();
+        sourceBank.setXYCoordinatesFromFixedSources(0, m_numOfSources, source.getDeltaX(), source.getDeltaY());
+        return;
     }
-}
-
-//==============================================================================
-void ControlGrisAudioProcessor::validateSourcePositions() {
-    int sourceLink = automationManager.getSourceLink();
-    int drawingType = automationManager.getDrawingType();
 
-    if (! getIsPlaying()) {
-        if (sourceLink != SOURCE_LINK_DELTA_LOCK && drawingType != TRAJECTORY_TYPE_DRAWING) {
-            automationManager.setSourceAndPlaybackPosition(sources[0].getPos());
+    sources[0].setPos(automationManager.getSourcePosition());
+    if (sourceLink >= SOURCE_LINK_CIRCULAR && sourceLink < SOURCE_LINK_DELTA_LOCK) {
+        if (isLbap) {
+            sourceBank.setCoordinatesFromFixedSources(1, m_numOfSources - 1, sources[0].getDeltaAzimuth(),
+                                                      0.0, sources[0].getDeltaDistance());
         } else {
-            automationManager.setPlaybackPositionX(-1.0f);
-            automationManager.setPlaybackPositionY(-1.0f);
+            sourceBank.setCoordinatesFromFixedSources(1, m_numOfSources - 1, sources[0].getDeltaAzimuth(),
+                                                      sources[0].getDeltaElevation(), 0.0);
         }
+    } else if (sourceLink == SOURCE_LINK_SYMMETRIC_X && m_numOfSources == 2) {
+        sources[1].setSymmetricX(sources[0].getX(), sources[0].getY());
+    } else if (sourceLink == SOURCE_LINK_SYMMETRIC_Y && m_numOfSources == 2) {
+        sources[1].setSymmetricY(sources[0].getX(), sources[0].getY());
     }
+}
 
+template <int sourceLink, bool isLbap>
+void ControlGrisAudioProcessor::validateSourcePositionsWith() {
     // Nothing to do for independent mode.
 
     // All circular modes.
     if (sourceLink >= SOURCE_LINK_CIRCULAR && sourceLink < SOURCE_LINK_DELTA_LOCK) {
-        if (getOscFormat() == SPAT_MODE_LBAP) {
-            float deltaAzimuth = sources[0].getDeltaAzimuth();
-            float deltaDistance = sources[0].getDeltaDistance();
-            for (int i = 1; i < m_numOfSources; i++) {
-                sources[i].setCoordinatesFromFixedSource(deltaAzimuth, 0.0, deltaDistance);
-            }
+        if (isLbap) {
+            sourceBank.setCoordinatesFromFixedSources(1, m_numOfSources - 1, sources[0].getDeltaAzimuth(),
+                                                      0.0, sources[0].getDeltaDistance());
         } else {
-            float deltaAzimuth = sources[0].getDeltaAzimuth();
-            float deltaElevation = sources[0].getDeltaElevation();
-            for (int i = 1; i < m_numOfSources; i++) {
-                sources[i].setCoordinatesFromFixedSource(deltaAzimuth, deltaElevation, 0.0);
-            }
+            sourceBank.setCoordinatesFromFixedSources(1, m_numOfSources - 1, sources[0].getDeltaAzimuth(),
+                                                      sources[0].getDeltaElevation(), 0.0);
         }
-    } 
+    }
     // Delta Lock mode.
     else if (sourceLink == SOURCE_LINK_DELTA_LOCK) {
-        float deltaX = sources[0].getDeltaX();
-        float deltaY = sources[0].getDeltaY();
-        for (int i = 1; i < m_numOfSources; i++) {
-            sources[i].setXYCoordinatesFromFixedSource(deltaX, deltaY);
-        }
+        sourceBank.setXYCoordinatesFromFixedSources(1, m_numOfSources - 1, sources[0].getDeltaX(), sources[0].getDeltaY());
     }
     // Symmetric X.
-    else if (sourceLink == SOURCE_LINK_SYMMETRIC_X) {
-        if (m_numOfSources == 2) {
-            float x = sources[0].getX();
-            float y = sources[0].getY();
-            sources[1].setSymmetricX(x, y);
-        }
+    else if (sourceLink == SOURCE_LINK_SYMMETRIC_X && m_numOfSources == 2) {
+        sources[1].setSymmetricX(sources[0].getX(), sources[0].getY());
     }
     // Symmetric Y.
-    else if (sourceLink == SOURCE_LINK_SYMMETRIC_Y) {
-        if (m_numOfSources == 2) {
-            float x = sources[0].getX();
-            float y = sources[0].getY();
-            sources[1].setSymmetricY(x, y);
+    else if (sourceLink == SOURCE_LINK_SYMMETRIC_Y && m_numOfSources == 2) {
+        sources[1].setSymmetricY(sources[0].getX(), sources[0].getY());
+    }
+}
+
+template <int sourceLinkAlt>
+void ControlGrisAudioProcessor::linkSourcePositionsAltWith() {
+    float y = automationManagerAlt.getSourcePosition().y;
+
+    if (sourceLinkAlt == SOURCE_LINK_ALT_INDEPENDENT) {
+        sources[0].setNormalizedElevation(y);
+    } else if (sourceLinkAlt == SOURCE_LINK_ALT_FIXED_ELEVATION) {
+        sourceBank.setElevations(0, m_numOfSources, y * 90.0, 0.0);
+    } else if (sourceLinkAlt == SOURCE_LINK_ALT_LINEAR_MIN) {
+        sourceBank.setElevations(0, m_numOfSources, y * 90.0, 60.0 / m_numOfSources);
+    } else if (sourceLinkAlt == SOURCE_LINK_ALT_LINEAR_MAX) {
+        sourceBank.setElevations(0, m_numOfSources, y * 90.0, -60.0 / m_numOfSources);
+    } else if (sourceLinkAlt == SOURCE_LINK_ALT_DELTA_LOCK) {
+        sourceBank.setElevationsFromFixedSources(0, m_numOfSources, automationManagerAlt.getSource().getDeltaY());
+    }
+}
+
+template <int sourceLinkAlt>
+void ControlGrisAudioProcessor::validateSourcePositionsAltWith() {
+    float increment = 60.0 / m_numOfSources;
+
+    if (sourceLinkAlt == SOURCE_LINK_ALT_FIXED_ELEVATION) {
+        sourceBank.setElevations(1, m_numOfSources - 1, sources[0].getElevation(), 0.0);
+    } else if (sourceLinkAlt == SOURCE_LINK_ALT_LINEAR_MIN) {
+        sourceBank.setElevations(1, m_numOfSources - 1, sources[0].getElevation() + increment, increment);
+    } else if (sourceLinkAlt == SOURCE_LINK_ALT_LINEAR_MAX) {
+        sourceBank.setElevations(1, m_numOfSources - 1, sources[0].getElevation() - increment, -increment);
+    } else if (sourceLinkAlt == SOURCE_LINK_ALT_DELTA_LOCK) {
+        sourceBank.setElevationsFromFixedSources(1, m_numOfSources - 1, sources[0].getDeltaElevation());
+    }
+}
+
+template <int sourceLink>
+void ControlGrisAudioProcessor::selectSourceLinkStrategies(bool isLbap) {
+    if (isLbap) {
+        m_linkStrategy = &ControlGrisAudioProcessor::linkSourcePositionsWith<sourceLink, true>;
+        m_validateStrategy = &ControlGrisAudioProcessor::validateSourcePositionsWith<sourceLink, true>;
+    } else {
+        m_linkStrategy = &ControlGrisAudioProcessor::linkSourcePositionsWith<sourceLink, false>;
+        m_validateStrategy = &ControlGrisAudioProcessor::validateSourcePositionsWith<sourceLink, false>;
+    }
+}
+
+template <int sourceLinkAlt>
+void ControlGrisAudioProcessor::selectSourceLinkAltStrategies() {
+    m_linkAltStrategy = &ControlGrisAudioProcessor::linkSourcePositionsAltWith<sourceLinkAlt>;
+    m_validateAltStrategy = &ControlGrisAudioProcessor::validateSourcePositionsAltWith<sourceLinkAlt>;
+}
+
+// Selects the strategies when the link modes or the spat mode have changed.
+void ControlGrisAudioProcessor::updateSourceLinkStrategies() {
+    int sourceLink = automationManager.getSourceLink();
+    if (sourceLink != m_strategySourceLink || m_selectedOscFormat != m_strategyOscFormat) {
+        bool isLbap = m_selectedOscFormat == SPAT_MODE_LBAP;
+        switch (sourceLink) {
+            case SOURCE_LINK_INDEPENDENT: selectSourceLinkStrategies<SOURCE_LINK_INDEPENDENT>(isLbap); break;
+            case SOURCE_LINK_CIRCULAR: selectSourceLinkStrategies<SOURCE_LINK_CIRCULAR>(isLbap); break;
+            case SOURCE_LINK_CIRCULAR_FIXED_RADIUS: selectSourceLinkStrategies<SOURCE_LINK_CIRCULAR_FIXED_RADIUS>(isLbap); break;
+            case SOURCE_LINK_CIRCULAR_FIXED_ANGLE: selectSourceLinkStrategies<SOURCE_LINK_CIRCULAR_FIXED_ANGLE>(isLbap); break;
+            case SOURCE_LINK_CIRCULAR_FULLY_FIXED: selectSourceLinkStrategies<SOURCE_LINK_CIRCULAR_FULLY_FIXED>(isLbap); break;
+            case SOURCE_LINK_DELTA_LOCK: selectSourceLinkStrategies<SOURCE_LINK_DELTA_LOCK>(isLbap); break;
+            case SOURCE_LINK_SYMMETRIC_X: selectSourceLinkStrategies<SOURCE_LINK_SYMMETRIC_X>(isLbap); break;
+            case SOURCE_LINK_SYMMETRIC_Y: selectSourceLinkStrategies<SOURCE_LINK_SYMMETRIC_Y>(isLbap); break;
+            default: selectSourceLinkStrategies<0>(isLbap); break;
+        }
+        m_strategySourceLink = sourceLink;
+        m_strategyOscFormat = m_selectedOscFormat;
+    }
+
+    int sourceLinkAlt = automationManagerAlt.getSourceLink();
+    if (sourceLinkAlt != m_strategySourceLinkAlt) {
+        switch (sourceLinkAlt) {
+            case SOURCE_LINK_ALT_INDEPENDENT: selectSourceLinkAltStrategies<SOURCE_LINK_ALT_INDEPENDENT>(); break;
+            case SOURCE_LINK_ALT_FIXED_ELEVATION: selectSourceLinkAltStrategies<SOURCE_LINK_ALT_FIXED_ELEVATION>(); break;
+            case SOURCE_LINK_ALT_LINEAR_MIN: selectSourceLinkAltStrategies<SOURCE_LINK_ALT_LINEAR_MIN>(); break;
+            case SOURCE_LINK_ALT_LINEAR_MAX: selectSourceLinkAltStrategies<SOURCE_LINK_ALT_LINEAR_MAX>(); break;
+            case SOURCE_LINK_ALT_DELTA_LOCK: selectSourceLinkAltStrategies<SOURCE_LINK_ALT_DELTA_LOCK>(); break;
+            default: selectSourceLinkAltStrategies<0>(); break;
+        }
+        m_strategySourceLinkAlt = sourceLinkAlt;
+    }
+}
+
+void ControlGrisAudioProcessor::linkSourcePositions() {
+    updateSourceLinkStrategies();
+    (this->*m_linkStrategy)();
+}
+
+void ControlGrisAudioProcessor::linkSourcePositionsAlt() {
+    updateSourceLinkStrategies();
+    (this->*m_linkAltStrategy)();
+}
+
+//==============================================================================
+void ControlGrisAudioProcessor::validateSourcePositions() {
+    int sourceLink = automationManager.getSourceLink();
+    int drawingType = automationManager.getDrawingType();
+
+    if (! getIsPlaying()) {
+        if (sourceLink != SOURCE_LINK_DELTA_LOCK && drawingType != TRAJECTORY_TYPE_DRAWING) {
+            automationManager.setSourceAndPlaybackPosition(sources[0].getPos());
+        } else {
+            automationManager.setPlaybackPositionX(-1.0f);
+            automationManager.setPlaybackPositionY(-1.0f);
         }
     }
 
+    updateSourceLinkStrategies();
+    (this->*m_validateStrategy)();
+
     // Fix source positions.
     automationManager.fixSourcePosition();
     bool shouldBeFixed = sourceLink != SOURCE_LINK_INDEPENDENT;
@@ -1216,33 +1558,8 @@ void ControlGrisAudioProcessor::validateSourcePositionsAlt() {
         }
     }
 
-    // Fixed elevation.
-    if (sourceLink == SOURCE_LINK_ALT_FIXED_ELEVATION) {
-        for (int i = 1; i < m_numOfSources; i++) {
-            sources[i].setElevation(sources[0].getElevation());
-        }
-    }
-    // Linear min.
-    else if (sourceLink == SOURCE_LINK_ALT_LINEAR_MIN) {
-        for (int i = 1; i < m_numOfSources; i++) {
-            float offset = sources[0].getElevation();
-            sources[i].setElevation(60.0 / m_numOfSources * i + offset);
-        }
-    }
-    // Linear max.
-    else if (sourceLink == SOURCE_LINK_ALT_LINEAR_MAX) {
-        for (int i = 1; i < m_numOfSources; i++) {
-            float offset = 90.0 - sources[0].getElevation();
-            sources[i].setElevation(90.0 - (60.0 / m_numOfSources * i) - offset);
-        }
-    }
-    // Delta lock.
-    else if (sourceLink == SOURCE_LINK_ALT_DELTA_LOCK) {
-        float deltaY = sources[0].getDeltaElevation();
-        for (int i = 1; i < m_numOfSources; i++) {
-            sources[i].setElevationFromFixedSource(deltaY);
-        }
-    }
+    updateSourceLinkStrategies();
+    (this->*m_validateAltStrategy)();
 
     // Fix source positions.
     automationManagerAlt.fixSourcePosition(); // not sure...
@@ -1279,7 +1596,7 @@ void ControlGrisAudioProcessor::addNewFixedPosition(int id) {
     // Build a new fixed position element.
     XmlElement *newData = new XmlElement("ITEM");
     newData->setAttribute("ID", id);
-    for (int i = 0; i < MAX_NUMBER_OF_SOURCES; i++) {
+    for (int i = 0; i < m_numOfSources; i++) {
         newData->setAttribute(getFixedPosSourceName(i, 0), sources[i].getX());
         newData->setAttribute(getFixedPosSourceName(i, 1), sources[i].getY());
         if (m_selectedOscFormat == SPAT_MODE_LBAP) {
@@ -1328,11 +1645,16 @@ bool ControlGrisAudioProcessor::recallFixedPosition(int id) {
     currentFixPosition = fpos;
     float x, y, z = 0.0;
     for (int i = 0; i < m_numOfSources; i++) {
+        // Sources added after the preset was saved are left where they are.
+        if (! currentFixPosition->hasAttribute(getFixedPosSourceName(i, 0))) {
+            continue;
+        }
         x = currentFixPosition->getDoubleAttribute(getFixedPosSourceName(i, 0));
         y = currentFixPosition->getDoubleAttribute(getFixedPosSourceName(i, 1));
         sources[i].setPos(Point<float> (x, y));
         sources[i].setFixedPosition(x, y);
-        if (m_selectedOscFormat == SPAT_MODE_LBAP) {
+        // Presets saved in another mode have no elevation.
+        if (m_selectedOscFormat == SPAT_MODE_LBAP && currentFixPosition->hasAttribute(getFixedPosSourceName(i, 2))) {
             z = currentFixPosition->getDoubleAttribute(getFixedPosSourceName(i, 2));
             sources[i].setFixedElevation(z);
             sources[i].setNormalizedElevation(z);
@@ -1347,12 +1669,10 @@ void ControlGrisAudioProcessor::copyFixedPositionXmlElement(XmlElement *src, Xml
         dest = new XmlElement(FIXED_POSITION_DATA_TAG);
 
     forEachXmlChildElement (*src, element) {
+        // A preset only holds the sources that were active when it was saved.
         XmlElement *newData = new XmlElement("ITEM");
-        newData->setAttribute("ID", element->getIntAttribute("ID"));
-        for (int i = 0; i < MAX_NUMBER_OF_SOURCES; i++) {
-            newData->setAttribute(getFixedPosSourceName(i, 0), element->getDoubleAttribute(getFixedPosSourceName(i, 0)));
-            newData->setAttribute(getFixedPosSourceName(i, 1), element->getDoubleAttribute(getFixedPosSourceName(i, 1)));
-            newData->setAttribute(getFixedPosSourceName(i, 2), element->getDoubleAttribute(getFixedPosSourceName(i, 2)));
+        for (int i = 0; i < element->getNumAttributes(); i++) {
+            newData->setAttribute(element->getAttributeName(i), element->getAttributeValue(i));
         }
 
         dest->addChildElement(newData);
@@ -1381,6 +1701,63 @@ void ControlGrisAudioProcessor::deleteFixedPosition(int id) {
     }
 }
 
+//==============================================================================
+void ControlGrisAudioProcessor::setSourceTrajectory(int sourceId, int drawingType, Point<float> startPosition,
+                                                    double period, double phaseOffset) {
+    if (! isPositiveAndBelow(sourceId, MAX_NUMBER_OF_SOURCES))
+        return;
+
+    if (drawingType < TRAJECTORY_TYPE_CIRCLE_CLOCKWISE) {
+        clearSourceTrajectory(sourceId);
+        return;
+    }
+
+    sourceTrajectories.setPeriod(sourceId, period);
+    sourceTrajectories.setPhaseOffset(sourceId, phaseOffset);
+    sourceTrajectories.setTrajectory(sourceId, TrajectoryShape(drawingType, startPosition));
+
+    String id(sourceId);
+    parameters.state.setProperty(String("p_trajectory_type_") + id, drawingType, nullptr);
+    parameters.state.setProperty(String("p_trajectory_x_") + id, startPosition.x, nullptr);
+    parameters.state.setProperty(String("p_trajectory_y_") + id, startPosition.y, nullptr);
+    parameters.state.setProperty(String("p_trajectory_period_") + id, sourceTrajectories.getPeriod(sourceId), nullptr);
+    parameters.state.setProperty(String("p_trajectory_phase_") + id, sourceTrajectories.getPhaseOffset(sourceId), nullptr);
+}
+
+void ControlGrisAudioProcessor::clearSourceTrajectory(int sourceId) {
+    if (! isPositiveAndBelow(sourceId, MAX_NUMBER_OF_SOURCES))
+        return;
+
+    sourceTrajectories.clearTrajectory(sourceId);
+
+    String id(sourceId);
+    parameters.state.removeProperty(String("p_trajectory_type_") + id, nullptr);
+    parameters.state.removeProperty(String("p_trajectory_x_") + id, nullptr);
+    parameters.state.removeProperty(String("p_trajectory_y_") + id, nullptr);
+    parameters.state.removeProperty(String("p_trajectory_period_") + id, nullptr);
+    parameters.state.removeProperty(String("p_trajectory_phase_") + id, nullptr);
+}
+
+bool ControlGrisAudioProcessor::hasSourceTrajectory(int sourceId) {
+    return isPositiveAndBelow(sourceId, MAX_NUMBER_OF_SOURCES) && sourceTrajectories.hasTrajectory(sourceId);
+}
+
+void ControlGrisAudioProcessor::setSourceTrajectoryTiming(int sourceId, double period, double phaseOffset) {
+    if (! hasSourceTrajectory(sourceId))
+        return;
+
+    sourceTrajectories.setPeriod(sourceId, period);
+    sourceTrajectories.setPhaseOffset(sourceId, phaseOffset);
+
+    String id(sourceId);
+    parameters.state.setProperty(String("p_trajectory_period_") + id, sourceTrajectories.getPeriod(sourceId), nullptr);
+    parameters.state.setProperty(String("p_trajectory_phase_") + id, sourceTrajectories.getPhaseOffset(sourceId), nullptr);
+}
+
+const SourceTrajectories& ControlGrisAudioProcessor::getSourceTrajectories() const {
+    return sourceTrajectories;
+}
+
 //==============================================================================
 double ControlGrisAudioProcessor::getInitTimeOnPlay() {
     return m_initTimeOnPlay >= 0.0 ? m_initTimeOnPlay : 0.0;
@@ -1463,19 +1840,13 @@ void ControlGrisAudioProcessor::changeProgramName (int index, const String& newN
 //==============================================================================
 void ControlGrisAudioProcessor::initialize() {
     m_needInitialization = true;
-    m_lastTime = m_lastTimerTime = 10000000.0;
+    m_lastTime = 10000000.0;
     m_canStopActivate = true;
 
     // If a preset is actually selected, we always recall it on initialize because
     // the automation won't trigger parameterChanged if it stays on the same value.
-    if (m_currentPositionPreset != 0) {
-        if (recallFixedPosition(m_currentPositionPreset)) {
-            ControlGrisAudioProcessorEditor *ed = dynamic_cast<ControlGrisAudioProcessorEditor *>(getActiveEditor());
-            if (ed != nullptr) {
-                ed->updatePositionPreset(m_currentPositionPreset);
-            }
-        }
-    }
+    // This can be called from processBlock, so the recall is left to the timer.
+    m_positionPresetRecallPending = true;
 }
 
 void ControlGrisAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock) {
@@ -1521,6 +1892,10 @@ void ControlGrisAudioProcessor::processBlock (AudioBuffer<float>& buffer, MidiBu
         phead->getCurrentPosition(playposinfo);
         m_isPlaying = playposinfo.isPlaying;
         m_bpm = playposinfo.bpm;
+        m_ppqPosition = playposinfo.ppqPosition;
+        if (playposinfo.timeSigDenominator > 0) {
+            m_quarterNotesPerBar = playposinfo.timeSigNumerator * 4.0 / playposinfo.timeSigDenominator;
+        }
         if (m_needInitialization) {
             m_initTimeOnPlay = m_currentTime = playposinfo.timeInSeconds < 0.0 ? 0.0 : playposinfo.timeInSeconds;
             m_needInitialization = false;
@@ -1535,6 +1910,17 @@ void ControlGrisAudioProcessor::processBlock (AudioBuffer<float>& buffer, MidiBu
             initialize();
         }
     }
+
+    // Trajectories follow the host clock (or its position in beats when they are synced to
+    // the tempo). Positions are evaluated at the start of each block and picked up by the
+    // timer on the message thread.
+    if (! m_needInitialization && m_currentTime != m_lastTime) {
+        double relativeTimeFromPlay = getCurrentTime() - getInitTimeOnPlay();
+        trajectoryManager.computeTrajectoryPosition(relativeTimeFromPlay, m_ppqPosition, m_quarterNotesPerBar);
+        // Periods of the sources are always in seconds, whatever the unit of the main trajectory.
+        sourceTrajectories.computePositions(relativeTimeFromPlay);
+    }
+
     m_lastTime = m_currentTime;
 }
 
@@ -1552,15 +1938,19 @@ AudioProcessorEditor* ControlGrisAudioProcessor::createEditor()
 //==============================================================================
 void ControlGrisAudioProcessor::getStateInformation (MemoryBlock& destData)
 {
-    for (int i = 0; i < MAX_NUMBER_OF_SOURCES; i++) {
+    // Like the rest of the plugin state (and fixPositionData), this is only safe on the
+    // message thread. The source positions are written to the copy, not to parameters.state.
+    auto state = parameters.copyState();
+
+    SourceFrame frames[MAX_NUMBER_OF_SOURCES];
+    int numberOfSources = sourceFrames.read(frames);
+    for (int i = 0; i < numberOfSources; i++) {
         String id(i);
-        parameters.state.setProperty(String("p_azimuth_") + id, sources[i].getNormalizedAzimuth(), nullptr);
-        parameters.state.setProperty(String("p_elevation_") + id, sources[i].getNormalizedElevation(), nullptr);
-        parameters.state.setProperty(String("p_distance_") + id, sources[i].getDistance(), nullptr);
+        state.setProperty(String("p_azimuth_") + id, frames[i].getNormalizedAzimuth(), nullptr);
+        state.setProperty(String("p_elevation_") + id, frames[i].getNormalizedElevation(), nullptr);
+        state.setProperty(String("p_distance_") + id, frames[i].distance, nullptr);
     }
 
-    auto state = parameters.copyState();
-
     std::unique_ptr<XmlElement> xmlState (state.createXml());
 
     if (xmlState.get() != nullptr) {
@@ -1587,8 +1977,13 @@ void ControlGrisAudioProcessor::setStateInformation (const void* data, int sizeI
         ValueTree valueTree = ValueTree::fromXml (*xmlState);
         setOscFormat((SPAT_MODE_ENUM)(int)valueTree.getProperty("oscFormat", 0));
         setOscPortNumber(valueTree.getProperty("oscPortNumber", 18032));
+        setOscOutputRate(valueTree.getProperty("oscOutputRate", DEFAULT_OSC_OUTPUT_RATE));
+        setOscBundleMode(valueTree.getProperty("oscBundleMode", false));
+        setOscMaxDatagramSize(valueTree.getProperty("oscMaxDatagramSize", DEFAULT_OSC_MAX_DATAGRAM_SIZE));
+        setOscKeepAliveInterval(valueTree.getProperty("oscKeepAliveInterval", DEFAULT_OSC_KEEP_ALIVE_INTERVAL));
+        setRecordingCapacity(valueTree.getProperty("recordingCapacity", DEFAULT_RECORDING_CAPACITY));
         handleOscConnection(valueTree.getProperty("oscConnected", true));
-        setNumberOfSources(valueTree.getProperty("numberOfSources", 1), false);
+        setNumberOfSources(valueTree.getProperty("numberOfSources", 1));
         setFirstSourceId(valueTree.getProperty("firstSourceId", 1));
         setOscOutputPluginId(valueTree.getProperty("oscOutputPluginId", 1));
 
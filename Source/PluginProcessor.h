@@ -22,6 +22,10 @@
 #include "../JuceLibraryCode/JuceHeader.h"
 #include "Source.h"
 #include "AutomationManager.h"
+#include "TrajectoryManager.h"
+#include "OscSenderThread.h"
+#include "SourceFrame.h"
+#include "SourceTrajectories.h"
 #include "ControlGrisConstants.h"
 #include "ControlGrisUtilities.h"
 
@@ -29,6 +33,7 @@ class ControlGrisAudioProcessor  : public AudioProcessor,
                                    public AudioProcessorValueTreeState::Listener,
                                    public AutomationManager::Listener,
                                    public Timer,
+                                   public HighResolutionTimer,
                                    private OSCReceiver::Listener<OSCReceiver::RealtimeCallback>
 {
 public:
@@ -79,12 +84,27 @@ public:
     void setOscPortNumber(int oscPortNumber);
     int getOscPortNumber();
 
-    void setFirstSourceId(int firstSourceId, bool propagate=true);
+    void setOscOutputRate(int rate);
+    int getOscOutputRate();
+
+    void setOscBundleMode(bool shouldUseBundles);
+    bool getOscBundleMode();
+    void setOscMaxDatagramSize(int numBytes);
+    int getOscMaxDatagramSize();
+
+    void setOscKeepAliveInterval(int milliseconds);
+    int getOscKeepAliveInterval();
+
+    // Maximum number of points kept while drawing a trajectory, in both fields.
+    void setRecordingCapacity(int numberOfPoints);
+    int getRecordingCapacity();
+
+    void setFirstSourceId(int firstSourceId);
     int getFirstSourceId();
 
     void setSelectedSourceId(int id);
 
-    void setNumberOfSources(int numOfSources, bool propagate=true);
+    void setNumberOfSources(int numOfSources);
     int getNumberOfSources();
 
     Source * getSources();
@@ -95,12 +115,18 @@ public:
     bool getOscConnected();
     void handleOscConnection(bool state);
     void sendOscMessage();
+    void requestOscFullRefresh();
+    int getOscQueueDepth() const;
+    int getOscDroppedFrameCount() const;
 
     bool createOscInputConnection(int oscPort);
     bool disconnectOSCInput(int oscPort);
     bool getOscInputConnected();
     void oscMessageReceived (const OSCMessage& message) override;
     void oscBundleReceived(const OSCBundle& bundle) override;
+    int getOscAddressHitCount(int address) const;
+    int getOscUnknownAddressCount() const;
+    int getOscControlDroppedCount() const;
 
     bool createOscOutputConnection(String oscAddress, int oscPort);
     bool disconnectOSCOutput(String oscAddress, int oscPort);
@@ -110,6 +136,7 @@ public:
     int getOscOutputPluginId();
 
     void timerCallback() override;
+    void hiResTimerCallback() override;
 
     //==============================================================================
     void setPluginState();
@@ -147,38 +174,58 @@ public:
     XmlElement * getFixedPositionData(); // retrieve all data.
     void deleteFixedPosition(int id);
 
+    // Independent trajectory of a single source. drawingType is one of the generated
+    // trajectory types (circle to triangle), built around startPosition.
+    void setSourceTrajectory(int sourceId, int drawingType, Point<float> startPosition, double period, double phaseOffset);
+    void clearSourceTrajectory(int sourceId);
+    bool hasSourceTrajectory(int sourceId);
+    // Changes the period and phase of an existing trajectory, keeping its shape and start position.
+    void setSourceTrajectoryTiming(int sourceId, double period, double phaseOffset);
+    const SourceTrajectories& getSourceTrajectories() const;
+
     //==============================================================================
     AudioProcessorValueTreeState parameters;
 
+    // Plays the trajectories drawn in automationManager (x, y) and automationManagerAlt (z).
+    TrajectoryManager trajectoryManager;
     AutomationManager automationManager;
     AutomationManager automationManagerAlt;
 
 private:
-    SPAT_MODE_ENUM m_selectedOscFormat;
-    bool m_oscConnected;
+    // Also read by sendOscMessage(), on the high resolution timer thread.
+    std::atomic<SPAT_MODE_ENUM> m_selectedOscFormat;
+    std::atomic<bool> m_oscConnected;
     bool m_oscInputConnected;
     bool m_oscOutputConnected;
     int m_firstSourceId;
     int m_numOfSources;
     int m_selectedSourceId;
     int m_currentOSCPort;
+    int m_oscOutputRate;
+    std::atomic<int> m_oscKeepAliveInterval;
+    std::atomic<bool> m_oscFullRefreshRequested;
+    double m_lastOscFullRefreshTime;
     int m_lastConnectedOSCPort;
     int m_currentOSCInputPort;
     int m_currentOSCOutputPort;
+    int m_oscOutputPluginId;
     String m_currentOSCOutputAddress;
     bool m_needInitialization;
 
     double m_initTimeOnPlay;
     double m_currentTime;
     double m_lastTime;
-    double m_lastTimerTime;
 
     bool m_isPlaying;
-    bool m_canStopActivate;
+    std::atomic<bool> m_canStopActivate;
     double m_bpm;
+    double m_ppqPosition;
+    double m_quarterNotesPerBar;
 
     int m_currentPositionPreset;
     int m_newPositionPreset;
+    // Set by initialize(), the current preset is recalled by the next timer callback.
+    std::atomic<bool> m_positionPresetRecallPending;
 
     // Filtering variables for OSC controller output.
     int m_lastPositionPreset;
@@ -190,12 +237,103 @@ private:
     int m_lastSourceLink;
     int m_lastSourceLinkAlt;
 
+    // Coordinates of all the sources, stored contiguously for the batch conversions.
+    SourceBank sourceBank;
     Source sources[MAX_NUMBER_OF_SOURCES];
 
-    OSCSender oscSender;
+    SourceTrajectories sourceTrajectories;
+
+    // Sources are only modified on the message thread. Other threads read them from this snapshot.
+    SourceFrameBuffer sourceFrames;
+    SourceFrame oscOutputFrames[MAX_NUMBER_OF_SOURCES];
+    uint32 m_lastSentSourceVersions[MAX_NUMBER_OF_SOURCES];
+
+    void publishSourceFrames();
+
+    // The source link solvers, one instantiation per link mode (and spat mode for
+    // the main link). The current ones are selected when the modes change.
+    typedef void (ControlGrisAudioProcessor::*SourceLinkStrategy)();
+    SourceLinkStrategy m_linkStrategy;
+    SourceLinkStrategy m_validateStrategy;
+    SourceLinkStrategy m_linkAltStrategy;
+    SourceLinkStrategy m_validateAltStrategy;
+    int m_strategySourceLink;
+    int m_strategySourceLinkAlt;
+    SPAT_MODE_ENUM m_strategyOscFormat;
+
+    template <int sourceLink, bool isLbap> void linkSourcePositionsWith();
+    template <int sourceLink, bool isLbap> void validateSourcePositionsWith();
+    template <int sourceLinkAlt> void linkSourcePositionsAltWith();
+    template <int sourceLinkAlt> void validateSourcePositionsAltWith();
+    template <int sourceLink> void selectSourceLinkStrategies(bool isLbap);
+    template <int sourceLinkAlt> void selectSourceLinkAltStrategies();
+    void updateSourceLinkStrategies();
+
+    OscSenderThread oscSenderThread;
     OSCSender oscOutputSender;
     OSCReceiver oscInputReceiver;
 
+    // Controller addresses for the current plugin id, indexed by OSC_ADDRESS_ENUM.
+    SpinLock oscAddressLock;
+    Array<OSCAddressPattern> oscAddressPatterns;
+    HashMap<String, int> oscAddressMap;
+    String oscAddressPrefix;
+
+    void rebuildOscAddressCache();
+    int findOscAddress(const String& address);
+
+    // Incoming controller messages are dispatched to these handlers, indexed by OSC_ADDRESS_ENUM.
+    std::function<void (const OSCMessage&)> oscAddressHandlers[OSC_ADDRESS_NUMBER_OF_ADDRESSES];
+    std::atomic<int> oscAddressHitCounts[OSC_ADDRESS_NUMBER_OF_ADDRESSES];
+    std::atomic<int> oscUnknownAddressCount;
+
+    void initOscAddressHandlers();
+
+    // A value written by another thread and applied by the timer. Only the latest
+    // value is kept, older ones are dropped.
+    struct PendingValue
+    {
+        std::atomic<float> value;
+        std::atomic<bool> pending;
+    };
+
+    // Controller values written by the OSC receiver thread.
+    enum OscControlSlot {
+        OSC_CONTROL_AZISPAN = 0,
+        OSC_CONTROL_ELESPAN,
+        OSC_CONTROL_SOURCE_LINK,
+        OSC_CONTROL_SOURCE_LINK_ALT,
+        OSC_CONTROL_PRESET,
+        OSC_CONTROL_NUMBER_OF_SLOTS
+    };
+
+    PendingValue oscControlSlots[OSC_CONTROL_NUMBER_OF_SLOTS];
+    std::atomic<int> oscControlDroppedCount;
+
+    // The trajectory position is kept as a whole, so the coordinates received in one
+    // message (/traj/1/xy, /traj/1/xyz) are always applied on the same timer tick.
+    struct PendingPosition
+    {
+        float x, y, z;
+        bool hasX, hasY, hasZ;
+    };
+
+    SpinLock oscPositionLock;
+    PendingPosition oscPosition;
+
+    void storeOscControlValue(int slot, float value);
+    bool takeOscControlValue(int slot, float& value);
+    void storeOscPosition(const float* x, const float* y, const float* z);
+    void applyOscControlValues();
+
+    // Parameter changes notified outside of the message thread (usually by the host
+    // on the audio thread), indexed like listenedParameterIds.
+    static const int kNumberOfListenedParameters = 8;
+    PendingValue deferredParameters[kNumberOfListenedParameters];
+
+    void deferParameterChange(const String& parameterID, float newValue);
+    void applyDeferredParameterChanges();
+
     XmlElement fixPositionData;
     XmlElement *currentFixPosition = nullptr;
 
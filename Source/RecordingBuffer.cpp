@@ -0,0 +1,104 @@
+/**************************************************************************
+ * Copyright 2018 UdeM - GRIS - Olivier Belanger                          *
+ *                                                                        *
+ * This file is part of ControlGris, a multi-source spatialization plugin *
+ *                                                                        *
+ * ControlGris is free software: you can redistribute it and/or modify    *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * ControlGris is distributed in the hope that it will be useful,         *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with ControlGris.  If not, see                           *
+ * <http://www.gnu.org/licenses/>.                                        *
+ *************************************************************************/
+#include "RecordingBuffer.h"
+
+RecordingBuffer::RecordingBuffer(int capacity) {
+    setCapacity(capacity);
+}
+
+RecordingBuffer::~RecordingBuffer() {}
+
+void RecordingBuffer::setCapacity(int newCapacity) {
+    // At least four points, and an even number so the decimation keeps half of them.
+    capacity = jmax(4, newCapacity + (newCapacity & 1));
+    points.allocate((size_t)capacity, true);
+    times.allocate((size_t)capacity, true);
+    clear();
+}
+
+int RecordingBuffer::getCapacity() const {
+    return capacity;
+}
+
+void RecordingBuffer::clear() {
+    numPoints = 0;
+    stride = 1;
+    pendingReplacements = 0;
+}
+
+void RecordingBuffer::add(Point<float> point, float time) {
+    if (pendingReplacements > 0 && numPoints > 1) {
+        points[numPoints - 1] = point;
+        times[numPoints - 1] = time;
+        pendingReplacements--;
+        return;
+    }
+
+    if (numPoints == capacity) {
+        decimate();
+    }
+
+    points[numPoints] = point;
+    times[numPoints] = time;
+    numPoints++;
+    pendingReplacements = stride - 1;
+}
+
+// Keeps the even points, except that the last slot keeps the latest point instead
+// of the one before it.
+void RecordingBuffer::decimate() {
+    int last = capacity / 2 - 1;
+    for (int i = 1; i < last; i++) {
+        points[i] = points[i * 2];
+        times[i] = times[i * 2];
+    }
+    points[last] = points[capacity - 1];
+    times[last] = times[capacity - 1];
+    numPoints = capacity / 2;
+    stride *= 2;
+}
+
+int RecordingBuffer::size() const {
+    return numPoints;
+}
+
+bool RecordingBuffer::isEmpty() const {
+    return numPoints == 0;
+}
+
+Point<float>& RecordingBuffer::getPoint(int index) {
+    return points[index];
+}
+
+float RecordingBuffer::getTime(int index) const {
+    return times[index];
+}
+
+Point<float> RecordingBuffer::getFirstPoint() const {
+    return numPoints > 0 ? points[0] : Point<float> ();
+}
+
+Point<float> RecordingBuffer::getLastPoint() const {
+    return numPoints > 0 ? points[numPoints - 1] : Point<float> ();
+}
+
+float RecordingBuffer::getLastTime() const {
+    return numPoints > 0 ? times[numPoints - 1] : 0.0f;
+}
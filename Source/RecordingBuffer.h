@@ -0,0 +1,66 @@
+/**************************************************************************
+ * Copyright 2018 UdeM - GRIS - Olivier Belanger                          *
+ *                                                                        *
+ * This file is part of ControlGris, a multi-source spatialization plugin *
+ *                                                                        *
+ * ControlGris is free software: you can redistribute it and/or modify    *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * ControlGris is distributed in the hope that it will be useful,         *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with ControlGris.  If not, see                           *
+ * <http://www.gnu.org/licenses/>.                                        *
+ *************************************************************************/
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+// Fixed-capacity storage of the points of a drawn trajectory, with the time at
+// which each one was recorded. The memory is allocated by setCapacity(), adding
+// points never allocates.
+//
+// When the buffer is full, every other point is dropped and from then on only
+// one point is kept for every two added, so a long drawing keeps its whole path
+// at a lower resolution. The last point always follows the latest one added.
+class RecordingBuffer
+{
+public:
+    explicit RecordingBuffer(int capacity);
+    ~RecordingBuffer();
+
+    // Clears the buffer. Not to be called while recording.
+    void setCapacity(int newCapacity);
+    int getCapacity() const;
+
+    void clear();
+    void add(Point<float> point, float time);
+
+    int size() const;
+    bool isEmpty() const;
+
+    Point<float>& getPoint(int index);
+    float getTime(int index) const;
+    Point<float> getFirstPoint() const;
+    Point<float> getLastPoint() const;
+    float getLastTime() const;
+
+private:
+    int capacity;
+    int numPoints;
+    // Number of points added for each point kept, and the number still to replace the last one.
+    int stride;
+    int pendingReplacements;
+
+    HeapBlock<Point<float>> points;
+    HeapBlock<float> times;
+
+    void decimate();
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RecordingBuffer)
+};
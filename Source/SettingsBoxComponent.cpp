@@ -55,7 +55,7 @@ SettingsBoxComponent::SettingsBoxComponent() {
 
     numOfSourcesEditor.setExplicitFocusOrder(2);
     numOfSourcesEditor.setText("2");
-    numOfSourcesEditor.setInputRestrictions(1, "12345678");
+    numOfSourcesEditor.setInputRestrictions(3, "0123456789");
     numOfSourcesEditor.onReturnKey = [this] {
             oscFormatCombo.grabKeyboardFocus();
         };
@@ -86,6 +86,85 @@ SettingsBoxComponent::SettingsBoxComponent() {
         };
     addAndMakeVisible(&firstSourceIdEditor);
 
+    oscOutputRateLabel.setText("OSC Rate (Hz):", NotificationType::dontSendNotification);
+    addAndMakeVisible(&oscOutputRateLabel);
+
+    oscOutputRateEditor.setExplicitFocusOrder(5);
+    oscOutputRateEditor.setText(String(DEFAULT_OSC_OUTPUT_RATE));
+    oscOutputRateEditor.setInputRestrictions(4, "0123456789");
+    oscOutputRateEditor.onReturnKey = [this] {
+            oscFormatCombo.grabKeyboardFocus();
+        };
+    oscOutputRateEditor.onFocusLost = [this] {
+            if (! oscOutputRateEditor.isEmpty()) {
+                listeners.call([&] (Listener& l) { l.settingsBoxOscOutputRateChanged(oscOutputRateEditor.getText().getIntValue()); });
+            } else {
+                listeners.call([&] (Listener& l) { l.settingsBoxOscOutputRateChanged(DEFAULT_OSC_OUTPUT_RATE); });
+            }
+        };
+    addAndMakeVisible(&oscOutputRateEditor);
+
+    oscBundleButton.setExplicitFocusOrder(6);
+    oscBundleButton.setButtonText("OSC Bundles");
+    oscBundleButton.onClick = [this] {
+            listeners.call([&] (Listener& l) { l.settingsBoxOscBundleModeChanged(oscBundleButton.getToggleState()); });
+        };
+    addAndMakeVisible(&oscBundleButton);
+
+    oscMaxDatagramSizeLabel.setText("Datagram Size:", NotificationType::dontSendNotification);
+    addAndMakeVisible(&oscMaxDatagramSizeLabel);
+
+    oscMaxDatagramSizeEditor.setExplicitFocusOrder(7);
+    oscMaxDatagramSizeEditor.setText(String(DEFAULT_OSC_MAX_DATAGRAM_SIZE));
+    oscMaxDatagramSizeEditor.setInputRestrictions(5, "0123456789");
+    oscMaxDatagramSizeEditor.onReturnKey = [this] {
+            oscFormatCombo.grabKeyboardFocus();
+        };
+    oscMaxDatagramSizeEditor.onFocusLost = [this] {
+            if (! oscMaxDatagramSizeEditor.isEmpty()) {
+                listeners.call([&] (Listener& l) { l.settingsBoxOscMaxDatagramSizeChanged(oscMaxDatagramSizeEditor.getText().getIntValue()); });
+            } else {
+                listeners.call([&] (Listener& l) { l.settingsBoxOscMaxDatagramSizeChanged(DEFAULT_OSC_MAX_DATAGRAM_SIZE); });
+            }
+        };
+    addAndMakeVisible(&oscMaxDatagramSizeEditor);
+
+    oscKeepAliveLabel.setText("Keep Alive (ms):", NotificationType::dontSendNotification);
+    addAndMakeVisible(&oscKeepAliveLabel);
+
+    oscKeepAliveEditor.setExplicitFocusOrder(8);
+    oscKeepAliveEditor.setText(String(DEFAULT_OSC_KEEP_ALIVE_INTERVAL));
+    oscKeepAliveEditor.setInputRestrictions(5, "0123456789");
+    oscKeepAliveEditor.onReturnKey = [this] {
+            oscFormatCombo.grabKeyboardFocus();
+        };
+    oscKeepAliveEditor.onFocusLost = [this] {
+            if (! oscKeepAliveEditor.isEmpty()) {
+                listeners.call([&] (Listener& l) { l.settingsBoxOscKeepAliveIntervalChanged(oscKeepAliveEditor.getText().getIntValue()); });
+            } else {
+                listeners.call([&] (Listener& l) { l.settingsBoxOscKeepAliveIntervalChanged(DEFAULT_OSC_KEEP_ALIVE_INTERVAL); });
+            }
+        };
+    addAndMakeVisible(&oscKeepAliveEditor);
+
+    recordingCapacityLabel.setText("Drawing Points:", NotificationType::dontSendNotification);
+    addAndMakeVisible(&recordingCapacityLabel);
+
+    recordingCapacityEditor.setExplicitFocusOrder(9);
+    recordingCapacityEditor.setText(String(DEFAULT_RECORDING_CAPACITY));
+    recordingCapacityEditor.setInputRestrictions(5, "0123456789");
+    recordingCapacityEditor.onReturnKey = [this] {
+            oscFormatCombo.grabKeyboardFocus();
+        };
+    recordingCapacityEditor.onFocusLost = [this] {
+            if (! recordingCapacityEditor.isEmpty()) {
+                listeners.call([&] (Listener& l) { l.settingsBoxRecordingCapacityChanged(recordingCapacityEditor.getText().getIntValue()); });
+            } else {
+                listeners.call([&] (Listener& l) { l.settingsBoxRecordingCapacityChanged(DEFAULT_RECORDING_CAPACITY); });
+            }
+        };
+    addAndMakeVisible(&recordingCapacityEditor);
+
     activateButton.setExplicitFocusOrder(1);
     activateButton.setButtonText("Activate OSC");
     activateButton.onClick = [this] {
@@ -106,6 +185,26 @@ void SettingsBoxComponent::setOscPortNumber(int oscPortNumber) {
     oscPortEditor.setText(String(oscPortNumber));
 }
 
+void SettingsBoxComponent::setOscOutputRate(int rate) {
+    oscOutputRateEditor.setText(String(rate));
+}
+
+void SettingsBoxComponent::setOscBundleMode(bool shouldUseBundles) {
+    oscBundleButton.setToggleState(shouldUseBundles, NotificationType::dontSendNotification);
+}
+
+void SettingsBoxComponent::setOscMaxDatagramSize(int numBytes) {
+    oscMaxDatagramSizeEditor.setText(String(numBytes));
+}
+
+void SettingsBoxComponent::setOscKeepAliveInterval(int milliseconds) {
+    oscKeepAliveEditor.setText(String(milliseconds));
+}
+
+void SettingsBoxComponent::setRecordingCapacity(int numberOfPoints) {
+    recordingCapacityEditor.setText(String(numberOfPoints));
+}
+
 void SettingsBoxComponent::setNumberOfSources(int numOfSources) {
     numOfSourcesEditor.setText(String(numOfSources));
 }
@@ -137,5 +236,20 @@ void SettingsBoxComponent::resized() {
     firstSourceIdLabel.setBounds(265, 40, 130, 15);
     firstSourceIdEditor.setBounds(395, 40, 40, 15);
 
-    activateButton.setBounds(5, 70, 150, 20);
+    oscOutputRateLabel.setBounds(265, 70, 130, 15);
+    oscOutputRateEditor.setBounds(395, 70, 40, 15);
+
+    oscBundleButton.setBounds(455, 10, 130, 20);
+
+    oscMaxDatagramSizeLabel.setBounds(455, 40, 95, 15);
+    oscMaxDatagramSizeEditor.setBounds(550, 40, 40, 15);
+
+    oscKeepAliveLabel.setBounds(455, 70, 95, 15);
+    oscKeepAliveEditor.setBounds(550, 70, 40, 15);
+
+
+    activateButton.setBounds(5, 70, 110, 20);
+
+    recordingCapacityLabel.setBounds(115, 70, 90, 15);
+    recordingCapacityEditor.setBounds(205, 70, 40, 15);
 }
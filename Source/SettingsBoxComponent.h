@@ -38,6 +38,11 @@ public:
     void setFirstSourceId(int firstSourceId);
     void setOscFormat(SPAT_MODE_ENUM mode);
     void setOscPortNumber(int oscPortNumber);
+    void setOscOutputRate(int rate);
+    void setOscBundleMode(bool shouldUseBundles);
+    void setOscMaxDatagramSize(int numBytes);
+    void setOscKeepAliveInterval(int milliseconds);
+    void setRecordingCapacity(int numberOfPoints);
     void setActivateButtonState(bool shouldBeOn);
 
     struct Listener
@@ -46,6 +51,11 @@ public:
 
         virtual void settingsBoxOscFormatChanged(SPAT_MODE_ENUM mode) = 0;
         virtual void settingsBoxOscPortNumberChanged(int oscPort) = 0;
+        virtual void settingsBoxOscOutputRateChanged(int rate) = 0;
+        virtual void settingsBoxOscBundleModeChanged(bool shouldUseBundles) = 0;
+        virtual void settingsBoxOscMaxDatagramSizeChanged(int numBytes) = 0;
+        virtual void settingsBoxOscKeepAliveIntervalChanged(int milliseconds) = 0;
+        virtual void settingsBoxRecordingCapacityChanged(int numberOfPoints) = 0;
         virtual void settingsBoxOscActivated(bool state) = 0;
         virtual void settingsBoxNumberOfSourcesChanged(int numOfSources) = 0;
         virtual void settingsBoxFirstSourceIdChanged(int firstSourceId) = 0;
@@ -69,6 +79,20 @@ private:
     Label           firstSourceIdLabel;
     TextEditor      firstSourceIdEditor;
 
+    Label           oscOutputRateLabel;
+    TextEditor      oscOutputRateEditor;
+
+    ToggleButton    oscBundleButton;
+
+    Label           oscMaxDatagramSizeLabel;
+    TextEditor      oscMaxDatagramSizeEditor;
+
+    Label           oscKeepAliveLabel;
+    TextEditor      oscKeepAliveEditor;
+
+    Label           recordingCapacityLabel;
+    TextEditor      recordingCapacityEditor;
+
     ToggleButton    activateButton;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SettingsBoxComponent)
@@ -18,78 +18,100 @@
  * <http://www.gnu.org/licenses/>.                                        *
  *************************************************************************/
 #include "Source.h"
+#include "ControlGrisMath.h"
 
-Source::Source() {
-    m_changed = false;
-    m_radiusIsElevation = true;
-    m_azimuth = 0.0;
-    m_elevation = 0.0;
-    m_elevationNoClip = 0.0;
-    m_distance = 1.0;
-    m_distanceNoClip = 1.0;
-    m_aziSpan = 0.0;
-    m_eleSpan = 0.0;
-    m_x = 0.0;
-    m_y = 0.0;
-    fixedX = 0.0;
-    fixedY = 0.0;
-    fixedAzimuth = -1.0;
-    fixedElevation = -1.0;
-    fixedDistance = -1.0;
+Source::Source() : m_ownBank(new SourceBank(1)), m_bank(m_ownBank.get()), m_index(0) {
     colour = Colours::black;
 }
 
 Source::~Source() {}
 
+void Source::setBank(SourceBank *newBank, int newIndex) {
+    newBank->azimuth[newIndex] = m_bank->azimuth[m_index];
+    newBank->elevation[newIndex] = m_bank->elevation[m_index];
+    newBank->elevationNoClip[newIndex] = m_bank->elevationNoClip[m_index];
+    newBank->distance[newIndex] = m_bank->distance[m_index];
+    newBank->distanceNoClip[newIndex] = m_bank->distanceNoClip[m_index];
+    newBank->azimuthSpan[newIndex] = m_bank->azimuthSpan[m_index];
+    newBank->elevationSpan[newIndex] = m_bank->elevationSpan[m_index];
+    newBank->x[newIndex] = m_bank->x[m_index];
+    newBank->y[newIndex] = m_bank->y[m_index];
+    newBank->radiusIsElevation[newIndex] = m_bank->radiusIsElevation[m_index];
+    newBank->fixedAzimuth[newIndex] = m_bank->fixedAzimuth[m_index];
+    newBank->fixedElevation[newIndex] = m_bank->fixedElevation[m_index];
+    newBank->fixedDistance[newIndex] = m_bank->fixedDistance[m_index];
+    newBank->fixedX[newIndex] = m_bank->fixedX[m_index];
+    newBank->fixedY[newIndex] = m_bank->fixedY[m_index];
+    newBank->changed[newIndex] = m_bank->changed[m_index];
+    newBank->polarOutdated[newIndex] = m_bank->polarOutdated[m_index];
+    newBank->cartesianOutdated[newIndex] = m_bank->cartesianOutdated[m_index];
+    m_bank = newBank;
+    m_index = newIndex;
+    m_ownBank.reset();
+}
+
 void Source::setId(int id) {
     m_id = id;
+    m_bank->changed[m_index] = true;
 }
 
 int Source::getId() {
     return m_id;
 }
 
+bool Source::getAndClearChanged() {
+    bool changed = m_bank->changed[m_index];
+    m_bank->changed[m_index] = false;
+    return changed;
+}
+
 void Source::setRadiusIsElevation(bool shouldBeElevation) {
-    m_radiusIsElevation = shouldBeElevation;
+    // Pending conversions use the current mode.
+    updatePolar();
+    updateCartesian();
+    m_bank->setRadiusIsElevation(m_index, shouldBeElevation);
 }
 
 void Source::setAzimuth(float azimuth) {
-    m_azimuth = azimuth;
-    computeXY();
+    updatePolar();
+    m_bank->azimuth[m_index] = azimuth;
+    m_bank->setPolarChanged(m_index);
 }
 
 void Source::setNormalizedAzimuth(float value) {
     if (value <= 0.5) {
-        m_azimuth = value * 360;
+        setAzimuth(value * 360);
     } else {
-        m_azimuth = (value - 1.0) * 360;
+        setAzimuth((value - 1.0) * 360);
     }
-    computeXY();
 }
 
 float Source::getAzimuth() {
-    return m_azimuth;
+    updatePolar();
+    return m_bank->azimuth[m_index];
 }
 
 float Source::getNormalizedAzimuth() {
-    float azimuth = m_azimuth  / 360.0;
+    float azimuth = getAzimuth() / 360.0;
     return azimuth >= 0 ? azimuth : azimuth + 1.0;
 }
 
 void Source::setElevationNoClip(float elevation) {
-    m_elevationNoClip = elevation;
-    setElevation(m_elevationNoClip);
+    updatePolar();
+    m_bank->elevationNoClip[m_index] = elevation;
+    setElevation(elevation);
 }
 
 void Source::setElevation(float elevation) {
+    updatePolar();
     if (elevation < 0.0) {
-        m_elevation = 0.0;
+        m_bank->elevation[m_index] = 0.0;
     } else if (elevation > 90.0) {
-        m_elevation = 90.0;
+        m_bank->elevation[m_index] = 90.0;
     } else {
-        m_elevationNoClip = m_elevation = elevation;
+        m_bank->elevationNoClip[m_index] = m_bank->elevation[m_index] = elevation;
     }
-    computeXY();
+    m_bank->setPolarChanged(m_index);
 }
 
 void Source::setNormalizedElevation(float value) {
@@ -97,223 +119,194 @@ void Source::setNormalizedElevation(float value) {
 }
 
 float Source::getElevation() {
-    return m_elevation;
+    updatePolar();
+    return m_bank->elevation[m_index];
 }
 
 float Source::getNormalizedElevation() {
-    return m_elevation / 90.0;
+    return getElevation() / 90.0;
 }
 
 void Source::setDistanceNoClip(float distance) {
-    m_distanceNoClip = distance;
-    setDistance(m_distanceNoClip);
+    updatePolar();
+    m_bank->distanceNoClip[m_index] = distance;
+    setDistance(distance);
 }
 
 void Source::setDistance(float distance) {
+    updatePolar();
     if (distance < 0.0) {
-        m_distance = 0.0;
+        m_bank->distance[m_index] = 0.0;
     } else {
-        m_distanceNoClip = m_distance = distance;
+        m_bank->distanceNoClip[m_index] = m_bank->distance[m_index] = distance;
     }
-    computeXY();
+    m_bank->setPolarChanged(m_index);
 }
 
 float Source::getDistance() {
-    return m_distance;
+    updatePolar();
+    return m_bank->distance[m_index];
 }
 
 void Source::setCoordinates(float azimuth, float elevation, float distance) {
-    m_azimuth = azimuth;
-    m_elevation = elevation;
-    m_distance = distance;
+    updatePolar();
+    m_bank->azimuth[m_index] = azimuth;
+    m_bank->elevation[m_index] = elevation;
+    m_bank->distance[m_index] = distance;
     computeXY();
     computeAzimuthElevation();
 }
 
 void Source::setAzimuthSpan(float azimuthSpan) {
-    m_aziSpan = azimuthSpan;
-    m_changed = true;
+    m_bank->azimuthSpan[m_index] = azimuthSpan;
+    m_bank->changed[m_index] = true;
 }
 
 float Source::getAzimuthSpan() {
-    return m_aziSpan;
+    return m_bank->azimuthSpan[m_index];
 }
 
 void Source::setElevationSpan(float elevationSpan) {
-    m_eleSpan = elevationSpan;
-    m_changed = true;
+    m_bank->elevationSpan[m_index] = elevationSpan;
+    m_bank->changed[m_index] = true;
 }
 
 float Source::getElevationSpan() {
-    return m_eleSpan;
+    return m_bank->elevationSpan[m_index];
 }
 
 void Source::setX(float x) {
-    m_x = x;
-    computeAzimuthElevation();
+    updateCartesian();
+    m_bank->x[m_index] = x;
+    m_bank->setCartesianChanged(m_index);
 }
 
 float Source::getX() {
-    return m_x;
+    updateCartesian();
+    return m_bank->x[m_index];
 }
 
 void Source::setY(float y) {
-    m_y = y;
-    computeAzimuthElevation();
+    updateCartesian();
+    m_bank->y[m_index] = y;
+    m_bank->setCartesianChanged(m_index);
 }
 
 float Source::getY() {
-    return m_y;
+    updateCartesian();
+    return m_bank->y[m_index];
 }
 
 Point<float> Source::getPos() {
-    return Point<float> {m_x, m_y};
+    updateCartesian();
+    return Point<float> {m_bank->x[m_index], m_bank->y[m_index]};
 }
 
 void Source::setPos(Point<float> pos) {
-    m_x = pos.x;
-    m_y = pos.y;
-    computeAzimuthElevation();
+    m_bank->x[m_index] = pos.x;
+    m_bank->y[m_index] = pos.y;
+    m_bank->cartesianOutdated[m_index] = false;
+    m_bank->setCartesianChanged(m_index);
 }
 
 void Source::computeXY() {
-    float radius;
-    if (m_radiusIsElevation) {  // azimuth - elevation
-        radius = (90.0 - m_elevation) / 90.0;
-    } else {                    // azimuth - distance
-        radius = m_distance;
-    }
-    m_x = radius * sinf(degreeToRadian(m_azimuth));
-    m_x = -m_x * 0.5 + 0.5;
-    m_x = m_x < 0.0 ? 0.0 : m_x > 1.0 ? 1.0 : m_x;
-    m_y = radius * cosf(degreeToRadian(m_azimuth));
-    m_y = m_y * 0.5 + 0.5;
-    m_y = m_y < 0.0 ? 0.0 : m_y > 1.0 ? 1.0 : m_y;
-    m_changed = true;
+    m_bank->computeXY(m_index, 1);
 }
 
 void Source::computeAzimuthElevation() {
-    float x = m_x * 2.0 - 1.0;
-    float y = m_y * 2.0 - 1.0;
-    if (x != 0.0 || y != 0.0) {
-        float ang = atan2f(x, y) / M_PI * 180.0;
-        if (ang <= -180) {
-            ang += 360.0;
-        }
-        m_azimuth = -ang;
-    }
-    float rad = sqrtf(x*x + y*y);
-    if (m_radiusIsElevation) {  // azimuth - elevation
-        rad = rad < 0.0 ? 0.0 : rad > 1.0 ? 1.0 : rad;
-        m_elevationNoClip = m_elevation = 90.0 - rad * 90.0;
-    } else {                    // azimuth - distance
-        rad = rad < 0.0 ? 0.0 : rad;
-        m_distanceNoClip = m_distance = rad;
-    }
-    m_changed = true;
+    m_bank->computeAzimuthElevation(m_index, 1);
 }
 
 void Source::fixSourcePosition(bool shouldBeFixed) {
     if (shouldBeFixed) {
-        fixedAzimuth = m_azimuth;
-        fixedElevation = m_elevationNoClip;
-        fixedDistance = m_distanceNoClip;
-        fixedX = m_x;
-        fixedY = m_y;
+        updatePolar();
+        updateCartesian();
+        m_bank->fixedAzimuth[m_index] = m_bank->azimuth[m_index];
+        m_bank->fixedElevation[m_index] = m_bank->elevationNoClip[m_index];
+        m_bank->fixedDistance[m_index] = m_bank->distanceNoClip[m_index];
+        m_bank->fixedX[m_index] = m_bank->x[m_index];
+        m_bank->fixedY[m_index] = m_bank->y[m_index];
     } else {
-        fixedAzimuth = -1.0;
-        fixedElevation = -1.0;
-        fixedDistance = -1.0;
-        fixedX = -1.0;
-        fixedY = -1.0;
+        m_bank->fixedAzimuth[m_index] = -1.0;
+        m_bank->fixedElevation[m_index] = -1.0;
+        m_bank->fixedDistance[m_index] = -1.0;
+        m_bank->fixedX[m_index] = -1.0;
+        m_bank->fixedY[m_index] = -1.0;
     }
 }
 
 void Source::fixSourcePositionElevation(bool shouldBeFixed) {
     if (shouldBeFixed) {
-        fixedElevation = m_elevation;
+        updatePolar();
+        m_bank->fixedElevation[m_index] = m_bank->elevation[m_index];
     } else {
-        fixedElevation = -1.0;
+        m_bank->fixedElevation[m_index] = -1.0;
     }
 }
 
 void Source::setFixedPosition(float x, float y) {
-    fixedX = x;
-    fixedY = y;
-    float fx = fixedX * 2.0 - 1.0;
-    float fy = fixedY * 2.0 - 1.0;
-    float ang = atan2f(fx, fy) / M_PI * 180.0;
+    m_bank->fixedX[m_index] = x;
+    m_bank->fixedY[m_index] = y;
+    float fx = x * 2.0 - 1.0;
+    float fy = y * 2.0 - 1.0;
+    float ang = fastAtan2(fx, fy) / M_PI * 180.0;
     if (ang <= -180) {
         ang += 360.0;
     }
-    fixedAzimuth = -ang;
+    m_bank->fixedAzimuth[m_index] = -ang;
     float rad = sqrtf(fx*fx + fy*fy);
-    if (m_radiusIsElevation) {  // azimuth - elevation
+    if (m_bank->getRadiusIsElevation(m_index)) {  // azimuth - elevation
         rad = rad < 0.0 ? 0.0 : rad > 1.0 ? 1.0 : rad;
-        fixedElevation = 90.0 - rad * 90.0;
+        m_bank->fixedElevation[m_index] = 90.0 - rad * 90.0;
     } else {                    // azimuth - distance
         rad = rad < 0.0 ? 0.0 : rad;
-        fixedDistance = rad;
+        m_bank->fixedDistance[m_index] = rad;
     }
 }
 
 void Source::setFixedElevation(float z) {
-    fixedElevation = 90.0 - z * 90.0;
+    m_bank->fixedElevation[m_index] = 90.0 - z * 90.0;
 }
 
 void Source::setCoordinatesFromFixedSource(float deltaAzimuth, float deltaElevation, float deltaDistance) {
-    if (m_radiusIsElevation) {  // azimuth - elevation
-        setAzimuth(fixedAzimuth + deltaAzimuth);
-        setElevationNoClip(fixedElevation + deltaElevation * 90.0f);
-    } else {                    // azimuth - distance
-        setAzimuth(fixedAzimuth + deltaAzimuth);
-        setDistanceNoClip(fixedDistance + deltaDistance);
-    }
-    computeXY();
+    m_bank->setCoordinatesFromFixedSources(m_index, 1, deltaAzimuth, deltaElevation, deltaDistance);
 }
 
 void Source::setSymmetricX(float x, float y) {
-        setX(x);
-        setY(1.f - y);
+        setPos(Point<float> (x, 1.f - y));
 }
 
 void Source::setSymmetricY(float x, float y) {
-        setX(1.f - x);
-        setY(y);
+        setPos(Point<float> (1.f - x, y));
 }
 
 void Source::setXYCoordinatesFromFixedSource(float deltaX, float deltaY) {
-    float x = fixedX + deltaX;
-    float y = fixedY + deltaY;
-    x = x < 0.0f ? 0.0f : x > 1.0f ? 1.0f : x;
-    y = y < 0.0f ? 0.0f : y > 1.0f ? 1.0f : y;
-    setX(x);
-    setY(y);
-    computeAzimuthElevation();
+    m_bank->setXYCoordinatesFromFixedSources(m_index, 1, deltaX, deltaY);
 }
 
 void Source::setElevationFromFixedSource(float deltaY) {
-    setElevation(fixedElevation + deltaY * 90.0f);
+    m_bank->setElevationsFromFixedSources(m_index, 1, deltaY);
 }
 
 float Source::getDeltaX() {
-    return m_x - fixedX;
+    return getX() - m_bank->fixedX[m_index];
 }
 
 float Source::getDeltaY() {
-    return m_y - fixedY;
+    return getY() - m_bank->fixedY[m_index];
 }
 
 float Source::getDeltaAzimuth() {
-    return (m_azimuth - fixedAzimuth);
+    return (getAzimuth() - m_bank->fixedAzimuth[m_index]);
 }
 
 float Source::getDeltaElevation() {
-    return (m_elevationNoClip - fixedElevation) / 90.0;
+    updatePolar();
+    return (m_bank->elevationNoClip[m_index] - m_bank->fixedElevation[m_index]) / 90.0;
 }
 
 float Source::getDeltaDistance() {
-    return (m_distance - fixedDistance);
+    return (getDistance() - m_bank->fixedDistance[m_index]);
 }
 
 void Source::setColour(Colour col) {
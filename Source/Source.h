@@ -19,7 +19,10 @@
  *************************************************************************/
 #pragma once
 
-#include "../JuceLibraryCode/JuceHeader.h"
+#ifndef CONTROLGRIS_STANDALONE
+ #include "../JuceLibraryCode/JuceHeader.h"
+#endif
+#include "SourceBank.h"
 
 #define SOURCE_ID_AZIMUTH 0
 #define SOURCE_ID_ELEVATION 1
@@ -32,15 +35,27 @@
 static const float kSourceRadius = 12;
 static const float kSourceDiameter = kSourceRadius * 2;
 
+// A sound source, with its coordinates stored in a SourceBank. The polar and
+// cartesian representations are converted lazily, so the getters write to the
+// bank too: a Source is only read or written on the message thread, which is
+// asserted in debug builds. The other threads read the SourceFrame snapshots
+// published by the processor instead.
 class Source
 {
 public:
     Source();
     ~Source();
 
+    // Moves the coordinates of the source to the slot index of bank. Until this
+    // is called, the source uses a bank of its own.
+    void setBank(SourceBank *newBank, int newIndex);
+
     void setId(int id);
     int getId();
 
+    // Returns true if the source has changed since the last call.
+    bool getAndClearChanged();
+
     void setRadiusIsElevation(bool shouldBeElevation);
 
     void setAzimuth(float azimuth);
@@ -96,27 +111,28 @@ public:
 
 private:
     int m_id;
-    bool m_changed;
-    bool m_radiusIsElevation;
-
-    float m_azimuth;
-    float m_elevation;
-    float m_elevationNoClip;
-    float m_distance;
-    float m_distanceNoClip;
-    float m_aziSpan;
-    float m_eleSpan;
-    float m_x;
-    float m_y;
 
-    Colour colour;
+    // Coordinates are stored in bank, at index.
+    std::unique_ptr<SourceBank> m_ownBank;
+    SourceBank *m_bank;
+    int m_index;
+
+    // Converts the representation about to be read, if it is outdated.
+    inline void updatePolar() {
+        assertMessageThread();
+        m_bank->updatePolar(m_index, 1);
+    }
+    inline void updateCartesian() {
+        assertMessageThread();
+        m_bank->updateCartesian(m_index, 1);
+    }
+
+    inline void assertMessageThread() const {
+#ifndef CONTROLGRIS_STANDALONE
+        jassert(MessageManager::existsAndIsCurrentThread());
+#endif
+    }
 
-    float fixedAzimuth;
-    float fixedElevation;
-    float fixedDistance;
-    float fixedX;
-    float fixedY;
-
-    inline double degreeToRadian(float degree) { return (degree / 360.0 * 2.0 * M_PI); }
+    Colour colour;
 
 };
@@ -0,0 +1,302 @@
+/**************************************************************************
+ * Copyright 2018 UdeM - GRIS - Olivier Belanger                          *
+ *                                                                        *
+ * This file is part of ControlGris, a multi-source spatialization plugin *
+ *                                                                        *
+ * ControlGris is free software: you can redistribute it and/or modify    *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * ControlGris is distributed in the hope that it will be useful,         *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with ControlGris.  If not, see                           *
+ * <http://www.gnu.org/licenses/>.                                        *
+ *************************************************************************/
+#include "SourceBank.h"
+#include "ControlGrisMath.h"
+
+static const int kNumberOfFields = 15;
+
+//==============================================================================
+template <typename Ops>
+static void computeXYLanes(SourceBank& bank, int index) {
+    typedef typename Ops::Vector Vector;
+    const Vector zero = Ops::set(0.0f);
+    const Vector one = Ops::set(1.0f);
+    const Vector half = Ops::set(0.5f);
+
+    Vector elevationRadius = Ops::div(Ops::sub(Ops::set(90.0f), Ops::load(bank.elevation + index)), Ops::set(90.0f));
+    Vector radius = Ops::select(Ops::notEqual(Ops::load(bank.radiusIsElevation + index), zero),
+                                elevationRadius, Ops::load(bank.distance + index));
+
+    Vector angle = Ops::mul(Ops::load(bank.azimuth + index), Ops::set(kMathPi / 180.0f));
+    Vector s = Ops::sin(angle);
+    Vector c = Ops::cos(angle);
+
+    Vector x = Ops::sub(half, Ops::mul(Ops::mul(radius, s), half));
+    Vector y = Ops::add(Ops::mul(Ops::mul(radius, c), half), half);
+    Ops::store(bank.x + index, Ops::min(Ops::max(x, zero), one));
+    Ops::store(bank.y + index, Ops::min(Ops::max(y, zero), one));
+}
+
+template <typename Ops>
+static void computeAzimuthElevationLanes(SourceBank& bank, int index) {
+    typedef typename Ops::Vector Vector;
+    typedef typename Ops::Mask Mask;
+    const Vector zero = Ops::set(0.0f);
+    const Vector one = Ops::set(1.0f);
+    const Vector two = Ops::set(2.0f);
+
+    Vector x = Ops::sub(Ops::mul(Ops::load(bank.x + index), two), one);
+    Vector y = Ops::sub(Ops::mul(Ops::load(bank.y + index), two), one);
+
+    // The azimuth is undefined at the center, keep the previous one.
+    Mask hasAngle = Ops::either(Ops::notEqual(x, zero), Ops::notEqual(y, zero));
+    Vector angle = Ops::mul(Ops::atan2(x, y), Ops::set(180.0f / kMathPi));
+    angle = Ops::select(Ops::lessEqual(angle, Ops::set(-180.0f)), Ops::add(angle, Ops::set(360.0f)), angle);
+    Ops::store(bank.azimuth + index, Ops::select(hasAngle, Ops::sub(zero, angle), Ops::load(bank.azimuth + index)));
+
+    Vector radius = Ops::sqrt(Ops::add(Ops::mul(x, x), Ops::mul(y, y)));
+    Mask isElevation = Ops::notEqual(Ops::load(bank.radiusIsElevation + index), zero);
+
+    Vector elevation = Ops::sub(Ops::set(90.0f), Ops::mul(Ops::min(radius, one), Ops::set(90.0f)));
+    Ops::store(bank.elevation + index, Ops::select(isElevation, elevation, Ops::load(bank.elevation + index)));
+    Ops::store(bank.elevationNoClip + index, Ops::select(isElevation, elevation, Ops::load(bank.elevationNoClip + index)));
+
+    Ops::store(bank.distance + index, Ops::select(isElevation, Ops::load(bank.distance + index), radius));
+    Ops::store(bank.distanceNoClip + index, Ops::select(isElevation, Ops::load(bank.distanceNoClip + index), radius));
+}
+
+//==============================================================================
+// Sets the elevation as Source::setElevation does: the clipped value is kept in
+// elevationNoClip only when it is in range.
+template <typename Ops>
+static inline void setElevationLanes(SourceBank& bank, int index, typename Ops::Vector elevation) {
+    typedef typename Ops::Vector Vector;
+    typedef typename Ops::Mask Mask;
+    const Vector zero = Ops::set(0.0f);
+    const Vector ninety = Ops::set(90.0f);
+
+    Mask inRange = Ops::both(Ops::lessEqual(zero, elevation), Ops::lessEqual(elevation, ninety));
+    Ops::store(bank.elevation + index, Ops::min(Ops::max(elevation, zero), ninety));
+    Ops::store(bank.elevationNoClip + index, Ops::select(inRange, elevation, Ops::load(bank.elevationNoClip + index)));
+}
+
+struct ComputeXYKernel
+{
+    template <typename Ops>
+    void process(SourceBank& bank, int index) const {
+        computeXYLanes<Ops>(bank, index);
+    }
+};
+
+struct ComputeAzimuthElevationKernel
+{
+    template <typename Ops>
+    void process(SourceBank& bank, int index) const {
+        computeAzimuthElevationLanes<Ops>(bank, index);
+    }
+};
+
+struct FixedCoordinatesKernel
+{
+    float deltaAzimuth, deltaElevation, deltaDistance;
+
+    template <typename Ops>
+    void process(SourceBank& bank, int index) const {
+        typedef typename Ops::Vector Vector;
+        typedef typename Ops::Mask Mask;
+        const Vector zero = Ops::set(0.0f);
+
+        Mask isElevation = Ops::notEqual(Ops::load(bank.radiusIsElevation + index), zero);
+        Ops::store(bank.azimuth + index, Ops::add(Ops::load(bank.fixedAzimuth + index), Ops::set(deltaAzimuth)));
+
+        Vector elevation = Ops::add(Ops::load(bank.fixedElevation + index), Ops::set(deltaElevation));
+        Ops::store(bank.elevationNoClip + index, Ops::select(isElevation, elevation, Ops::load(bank.elevationNoClip + index)));
+        Ops::store(bank.elevation + index, Ops::select(isElevation, Ops::min(Ops::max(elevation, zero), Ops::set(90.0f)),
+                                                       Ops::load(bank.elevation + index)));
+
+        Vector distance = Ops::add(Ops::load(bank.fixedDistance + index), Ops::set(deltaDistance));
+        Ops::store(bank.distanceNoClip + index, Ops::select(isElevation, Ops::load(bank.distanceNoClip + index), distance));
+        Ops::store(bank.distance + index, Ops::select(isElevation, Ops::load(bank.distance + index), Ops::max(distance, zero)));
+
+        computeXYLanes<Ops>(bank, index);
+    }
+};
+
+struct FixedXYKernel
+{
+    float deltaX, deltaY;
+
+    template <typename Ops>
+    void process(SourceBank& bank, int index) const {
+        typedef typename Ops::Vector Vector;
+        const Vector zero = Ops::set(0.0f);
+        const Vector one = Ops::set(1.0f);
+
+        Vector x = Ops::add(Ops::load(bank.fixedX + index), Ops::set(deltaX));
+        Vector y = Ops::add(Ops::load(bank.fixedY + index), Ops::set(deltaY));
+        Ops::store(bank.x + index, Ops::min(Ops::max(x, zero), one));
+        Ops::store(bank.y + index, Ops::min(Ops::max(y, zero), one));
+
+        computeAzimuthElevationLanes<Ops>(bank, index);
+    }
+};
+
+struct FixedElevationKernel
+{
+    float deltaElevation;
+
+    template <typename Ops>
+    void process(SourceBank& bank, int index) const {
+        setElevationLanes<Ops>(bank, index, Ops::add(Ops::load(bank.fixedElevation + index), Ops::set(deltaElevation)));
+        computeXYLanes<Ops>(bank, index);
+    }
+};
+
+struct ElevationRampKernel
+{
+    int startIndex;
+    float elevation, increment;
+
+    template <typename Ops>
+    void process(SourceBank& bank, int index) const {
+        typename Ops::Vector steps = Ops::add(Ops::set((float)(index - startIndex)), Ops::lanes());
+        setElevationLanes<Ops>(bank, index, Ops::add(Ops::set(elevation), Ops::mul(steps, Ops::set(increment))));
+        computeXYLanes<Ops>(bank, index);
+    }
+};
+
+// Runs kernel on a range of sources: scalar up to the first aligned source,
+// then 4 sources at a time and scalar again for the remainder.
+template <typename Kernel>
+static void processRange(SourceBank& bank, int startIndex, int numSources, const Kernel& kernel) {
+    jassert(startIndex >= 0 && startIndex + numSources <= bank.getCapacity());
+    int index = startIndex, end = startIndex + numSources;
+#if CONTROLGRIS_MATH_HAS_VECTOR_OPS
+    for (; index < end && (index & 3) != 0; index++) {
+        kernel.template process<ScalarMathOps>(bank, index);
+    }
+    for (; index + VectorMathOps::size <= end; index += VectorMathOps::size) {
+        kernel.template process<VectorMathOps>(bank, index);
+    }
+#endif
+    for (; index < end; index++) {
+        kernel.template process<ScalarMathOps>(bank, index);
+    }
+
+    for (index = startIndex; index < end; index++) {
+        bank.changed[index] = true;
+        bank.polarOutdated[index] = bank.cartesianOutdated[index] = false;
+    }
+}
+
+//==============================================================================
+SourceBank::SourceBank(int numberOfSources) : capacity(numberOfSources) {
+    int stride = (capacity + 3) & ~3;
+
+    // Room to align the first array on 16 bytes.
+    storage.calloc((size_t)(kNumberOfFields * stride + 4));
+    float* first = reinterpret_cast<float*>((reinterpret_cast<pointer_sized_int>(storage.get()) + 15) & ~(pointer_sized_int)15);
+
+    float** fields[kNumberOfFields] = { &azimuth, &elevation, &elevationNoClip, &distance, &distanceNoClip,
+                                        &azimuthSpan, &elevationSpan, &x, &y, &radiusIsElevation,
+                                        &fixedAzimuth, &fixedElevation, &fixedDistance, &fixedX, &fixedY };
+    for (int i = 0; i < kNumberOfFields; i++) {
+        *fields[i] = first + i * stride;
+    }
+
+    flags.calloc((size_t)(3 * stride));
+    changed = flags.get();
+    polarOutdated = changed + stride;
+    cartesianOutdated = polarOutdated + stride;
+
+    for (int i = 0; i < stride; i++) {
+        distance[i] = distanceNoClip[i] = 1.0f;
+        radiusIsElevation[i] = 1.0f;
+        fixedAzimuth[i] = fixedElevation[i] = fixedDistance[i] = -1.0f;
+        changed[i] = true;
+    }
+}
+
+SourceBank::~SourceBank() {}
+
+int SourceBank::getCapacity() const {
+    return capacity;
+}
+
+void SourceBank::setRadiusIsElevation(int index, bool shouldBeElevation) {
+    radiusIsElevation[index] = shouldBeElevation ? 1.0f : 0.0f;
+}
+
+bool SourceBank::getRadiusIsElevation(int index) const {
+    return radiusIsElevation[index] != 0.0f;
+}
+
+void SourceBank::computeXY(int startIndex, int numSources) {
+    updatePolar(startIndex, numSources);
+    processRange(*this, startIndex, numSources, ComputeXYKernel());
+}
+
+void SourceBank::computeAzimuthElevation(int startIndex, int numSources) {
+    updateCartesian(startIndex, numSources);
+    processRange(*this, startIndex, numSources, ComputeAzimuthElevationKernel());
+}
+
+void SourceBank::setPolarChanged(int index) {
+    cartesianOutdated[index] = changed[index] = true;
+}
+
+void SourceBank::setCartesianChanged(int index) {
+    polarOutdated[index] = changed[index] = true;
+}
+
+void SourceBank::updatePolar(int startIndex, int numSources) {
+    for (int i = startIndex; i < startIndex + numSources; i++) {
+        if (polarOutdated[i]) {
+            computeAzimuthElevationLanes<ScalarMathOps>(*this, i);
+            polarOutdated[i] = false;
+        }
+    }
+}
+
+void SourceBank::updateCartesian(int startIndex, int numSources) {
+    for (int i = startIndex; i < startIndex + numSources; i++) {
+        if (cartesianOutdated[i]) {
+            computeXYLanes<ScalarMathOps>(*this, i);
+            cartesianOutdated[i] = false;
+        }
+    }
+}
+
+// The solvers below keep the fields they don't replace, so the polar
+// representation has to be up to date first.
+void SourceBank::setCoordinatesFromFixedSources(int startIndex, int numSources, float deltaAzimuth,
+                                                float deltaElevation, float deltaDistance) {
+    updatePolar(startIndex, numSources);
+    FixedCoordinatesKernel kernel = { deltaAzimuth, deltaElevation * 90.0f, deltaDistance };
+    processRange(*this, startIndex, numSources, kernel);
+}
+
+void SourceBank::setXYCoordinatesFromFixedSources(int startIndex, int numSources, float deltaX, float deltaY) {
+    updatePolar(startIndex, numSources);
+    FixedXYKernel kernel = { deltaX, deltaY };
+    processRange(*this, startIndex, numSources, kernel);
+}
+
+void SourceBank::setElevationsFromFixedSources(int startIndex, int numSources, float deltaElevation) {
+    updatePolar(startIndex, numSources);
+    FixedElevationKernel kernel = { deltaElevation * 90.0f };
+    processRange(*this, startIndex, numSources, kernel);
+}
+
+void SourceBank::setElevations(int startIndex, int numSources, float elevation, float increment) {
+    updatePolar(startIndex, numSources);
+    ElevationRampKernel kernel = { startIndex, elevation, increment };
+    processRange(*this, startIndex, numSources, kernel);
+}
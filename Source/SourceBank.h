@@ -0,0 +1,101 @@
+/**************************************************************************
+ * Copyright 2018 UdeM - GRIS - Olivier Belanger                          *
+ *                                                                        *
+ * This file is part of ControlGris, a multi-source spatialization plugin *
+ *                                                                        *
+ * ControlGris is free software: you can redistribute it and/or modify    *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * ControlGris is distributed in the hope that it will be useful,         *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with ControlGris.  If not, see                           *
+ * <http://www.gnu.org/licenses/>.                                        *
+ *************************************************************************/
+#pragma once
+
+#ifndef CONTROLGRIS_STANDALONE
+ #include "../JuceLibraryCode/JuceHeader.h"
+#endif
+
+// Storage for the hot fields of a group of sources, laid out as one contiguous
+// array per field (structure of arrays) so that the polar <-> cartesian
+// conversions and the source link solvers can run on a whole group in a single
+// vectorised pass.
+//
+// Arrays are aligned on 16 bytes and padded to a multiple of 4 sources. All
+// the batch functions work on the sources in [startIndex, startIndex + numSources)
+// and flag them as changed.
+//
+// Conversions are lazy: writing one representation (polar or cartesian) only
+// marks the other one as outdated, and it is converted when it is read.
+class SourceBank
+{
+public:
+    explicit SourceBank(int capacity);
+    ~SourceBank();
+
+    int getCapacity() const;
+
+    void setRadiusIsElevation(int index, bool shouldBeElevation);
+    bool getRadiusIsElevation(int index) const;
+
+    // Updates x and y from azimuth and elevation (or distance).
+    void computeXY(int startIndex, int numSources);
+
+    // Updates azimuth and elevation (or distance) from x and y.
+    void computeAzimuthElevation(int startIndex, int numSources);
+
+    // Call after writing the polar (or cartesian) fields of a source.
+    void setPolarChanged(int index);
+    void setCartesianChanged(int index);
+
+    // Converts the outdated representations. Call before reading the fields.
+    void updatePolar(int startIndex, int numSources);
+    void updateCartesian(int startIndex, int numSources);
+
+    // Moves the sources by a delta from their fixed position. deltaElevation is normalized.
+    void setCoordinatesFromFixedSources(int startIndex, int numSources, float deltaAzimuth,
+                                        float deltaElevation, float deltaDistance);
+    void setXYCoordinatesFromFixedSources(int startIndex, int numSources, float deltaX, float deltaY);
+    void setElevationsFromFixedSources(int startIndex, int numSources, float deltaElevation);
+
+    // Sets the elevation of the source at startIndex + i to elevation + i * increment.
+    void setElevations(int startIndex, int numSources, float elevation, float increment);
+
+    float* azimuth;
+    float* elevation;
+    float* elevationNoClip;
+    float* distance;
+    float* distanceNoClip;
+    float* azimuthSpan;
+    float* elevationSpan;
+    float* x;
+    float* y;
+
+    // 1 when the radius of the source in the field is its elevation, 0 when it is its distance.
+    float* radiusIsElevation;
+
+    // Reference position of the linked sources (-1 when not fixed).
+    float* fixedAzimuth;
+    float* fixedElevation;
+    float* fixedDistance;
+    float* fixedX;
+    float* fixedY;
+
+    bool* changed;
+    bool* polarOutdated;
+    bool* cartesianOutdated;
+
+private:
+    int capacity;
+    HeapBlock<float> storage;
+    HeapBlock<bool> flags;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SourceBank)
+};
@@ -74,6 +74,42 @@ SourceBoxComponent::SourceBoxComponent() {
             currentAngle = (float)angleSlider.getValue();
             listeners.call([&] (Listener& l) { l.sourceBoxPositionChanged(selectedSourceNumber, currentAngle, currentRayLength); });
         };
+
+    // Own trajectory of the selected source. Item ids are the trajectory types,
+    // "None" (id 1) removes the trajectory.
+    trajectoryTypeLabel.setText("Own Trajectory:", NotificationType::dontSendNotification);
+    addAndMakeVisible(&trajectoryTypeLabel);
+
+    addAndMakeVisible(&trajectoryTypeCombo);
+    trajectoryTypeCombo.addItem("None", 1);
+    for (int i = TRAJECTORY_TYPE_CIRCLE_CLOCKWISE; i <= TRAJECTORY_TYPE_TRIANGLE_COUNTER_CLOCKWISE; i++) {
+        trajectoryTypeCombo.addItem(TRAJECTORY_TYPE_TYPES[i - 1], i);
+    }
+    trajectoryTypeCombo.setSelectedId(1, NotificationType::dontSendNotification);
+    trajectoryTypeCombo.onChange = [this] { notifyTrajectoryChanged(); };
+
+    trajectoryPeriodLabel.setText("Period (sec.):", NotificationType::dontSendNotification);
+    addAndMakeVisible(&trajectoryPeriodLabel);
+
+    trajectoryPeriodEditor.setText("5", false);
+    trajectoryPeriodEditor.setInputRestrictions(6, "0123456789.");
+    trajectoryPeriodEditor.onReturnKey = [this] {
+            sourcePlacementCombo.grabKeyboardFocus();
+        };
+    trajectoryPeriodEditor.onFocusLost = [this] { notifyTrajectoryChanged(); };
+    addAndMakeVisible(&trajectoryPeriodEditor);
+
+    // Fraction of the period, from 0 to 1.
+    trajectoryPhaseLabel.setText("Phase:", NotificationType::dontSendNotification);
+    addAndMakeVisible(&trajectoryPhaseLabel);
+
+    trajectoryPhaseEditor.setText("0", false);
+    trajectoryPhaseEditor.setInputRestrictions(5, "0123456789.");
+    trajectoryPhaseEditor.onReturnKey = [this] {
+            sourcePlacementCombo.grabKeyboardFocus();
+        };
+    trajectoryPhaseEditor.onFocusLost = [this] { notifyTrajectoryChanged(); };
+    addAndMakeVisible(&trajectoryPhaseEditor);
 }
 
 SourceBoxComponent::~SourceBoxComponent() {
@@ -98,6 +134,25 @@ void SourceBoxComponent::resized() {
 
     angleLabel.setBounds(305, 70, 150, 15);
     angleSlider.setBounds(380, 70, 200, 20);
+
+    trajectoryTypeLabel.setBounds(5, 40, 150, 15);
+    trajectoryTypeCombo.setBounds(130, 40, 150, 20);
+
+    trajectoryPeriodLabel.setBounds(5, 70, 90, 15);
+    trajectoryPeriodEditor.setBounds(95, 70, 50, 15);
+
+    trajectoryPhaseLabel.setBounds(170, 70, 60, 15);
+    trajectoryPhaseEditor.setBounds(230, 70, 50, 15);
+}
+
+void SourceBoxComponent::notifyTrajectoryChanged() {
+    int drawingType = trajectoryTypeCombo.getSelectedId();
+    if (drawingType < TRAJECTORY_TYPE_CIRCLE_CLOCKWISE) {
+        drawingType = 0;
+    }
+    double period = trajectoryPeriodEditor.getText().getDoubleValue();
+    double phase = trajectoryPhaseEditor.getText().getDoubleValue();
+    listeners.call([&] (Listener& l) { l.sourceBoxTrajectoryChanged(selectedSourceNumber, drawingType, period, phase); });
 }
 
 void SourceBoxComponent::setNumberOfSources(int numOfSources, int firstSourceId) {
@@ -126,3 +181,17 @@ void SourceBoxComponent::updateSelectedSource(Source *source, int sourceIndex, S
     angleSlider.setValue(currentAngle, NotificationType::dontSendNotification);
     rayLengthSlider.setValue(currentRayLength, NotificationType::dontSendNotification);
 }
+
+void SourceBoxComponent::updateSelectedSourceTrajectory(int drawingType, double period, double phase) {
+    trajectoryTypeCombo.setSelectedId(drawingType >= TRAJECTORY_TYPE_CIRCLE_CLOCKWISE ? drawingType : 1,
+                                      NotificationType::dontSendNotification);
+    // This is called on every refresh, the text being edited is left alone.
+    if (! trajectoryPeriodEditor.hasKeyboardFocus(true)) {
+        trajectoryPeriodEditor.setText(String(period), false);
+    }
+    if (! trajectoryPhaseEditor.hasKeyboardFocus(true)) {
+        trajectoryPhaseEditor.setText(String(phase), false);
+    }
+    trajectoryPeriodEditor.setEnabled(drawingType >= TRAJECTORY_TYPE_CIRCLE_CLOCKWISE);
+    trajectoryPhaseEditor.setEnabled(drawingType >= TRAJECTORY_TYPE_CIRCLE_CLOCKWISE);
+}
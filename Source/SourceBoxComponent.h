@@ -35,6 +35,8 @@ public:
 
     void setNumberOfSources(int numOfSources, int firstSourceId);
     void updateSelectedSource(Source *source, int sourceIndex, SPAT_MODE_ENUM spatMode);
+    // drawingType is 0 when the selected source has no trajectory of its own.
+    void updateSelectedSourceTrajectory(int drawingType, double period, double phase);
 
     struct Listener
     {
@@ -43,6 +45,7 @@ public:
         virtual void sourceBoxPlacementChanged(int value) = 0;
         virtual void sourceBoxSelectionChanged(int sourceNum) = 0;
         virtual void sourceBoxPositionChanged(int sourceNum, float angle, float rayLen) = 0;
+        virtual void sourceBoxTrajectoryChanged(int sourceNum, int drawingType, double period, double phase) = 0;
     };
 
     void addListener(Listener* l) { listeners.add (l); }
@@ -67,5 +70,16 @@ private:
     Label           angleLabel;
     Slider          angleSlider;
 
+    Label           trajectoryTypeLabel;
+    ComboBox        trajectoryTypeCombo;
+
+    Label           trajectoryPeriodLabel;
+    TextEditor      trajectoryPeriodEditor;
+
+    Label           trajectoryPhaseLabel;
+    TextEditor      trajectoryPhaseEditor;
+
+    void notifyTrajectoryChanged();
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SourceBoxComponent)
 };
@@ -0,0 +1,88 @@
+/**************************************************************************
+ * Copyright 2018 UdeM - GRIS - Olivier Belanger                          *
+ *                                                                        *
+ * This file is part of ControlGris, a multi-source spatialization plugin *
+ *                                                                        *
+ * ControlGris is free software: you can redistribute it and/or modify    *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * ControlGris is distributed in the hope that it will be useful,         *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with ControlGris.  If not, see                           *
+ * <http://www.gnu.org/licenses/>.                                        *
+ *************************************************************************/
+#include "SourceFrame.h"
+
+float SourceFrame::getNormalizedAzimuth() const {
+    float value = azimuth / 360.0;
+    return value >= 0 ? value : value + 1.0;
+}
+
+float SourceFrame::getNormalizedElevation() const {
+    return elevation / 90.0;
+}
+
+//==============================================================================
+SourceFrameBuffer::SourceFrameBuffer() {
+    for (int i = 0; i < 2; i++) {
+        snapshots[i].sequence = 0;
+        snapshots[i].numberOfSources = 0;
+        zeromem(snapshots[i].frames, sizeof(snapshots[i].frames));
+    }
+    zeromem(versions, sizeof(versions));
+    current = 0;
+}
+
+SourceFrameBuffer::~SourceFrameBuffer() {}
+
+void SourceFrameBuffer::publish(Source* sources, int numberOfSources) {
+    Snapshot& snapshot = snapshots[1 - current.load(std::memory_order_relaxed)];
+
+    // An odd sequence tells the readers that the snapshot is being written.
+    snapshot.sequence.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    snapshot.numberOfSources = numberOfSources;
+    for (int i = 0; i < numberOfSources; i++) {
+        if (sources[i].getAndClearChanged()) {
+            versions[i]++;
+        }
+        SourceFrame& frame = snapshot.frames[i];
+        frame.id = sources[i].getId();
+        frame.azimuth = sources[i].getAzimuth();
+        frame.elevation = sources[i].getElevation();
+        frame.distance = sources[i].getDistance();
+        frame.x = sources[i].getX();
+        frame.y = sources[i].getY();
+        frame.azimuthSpan = sources[i].getAzimuthSpan();
+        frame.elevationSpan = sources[i].getElevationSpan();
+        frame.version = versions[i];
+    }
+
+    snapshot.sequence.fetch_add(1, std::memory_order_release);
+    current.store(1 - current.load(std::memory_order_relaxed), std::memory_order_release);
+}
+
+int SourceFrameBuffer::read(SourceFrame* dest) const {
+    while (true) {
+        const Snapshot& snapshot = snapshots[current.load(std::memory_order_acquire)];
+        uint32 sequence = snapshot.sequence.load(std::memory_order_acquire);
+        if (sequence & 1) {
+            continue;
+        }
+
+        int numberOfSources = snapshot.numberOfSources;
+        memcpy(dest, snapshot.frames, sizeof(SourceFrame) * (size_t)numberOfSources);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (snapshot.sequence.load(std::memory_order_relaxed) == sequence) {
+            return numberOfSources;
+        }
+    }
+}
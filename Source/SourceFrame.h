@@ -0,0 +1,80 @@
+/**************************************************************************
+ * Copyright 2018 UdeM - GRIS - Olivier Belanger                          *
+ *                                                                        *
+ * This file is part of ControlGris, a multi-source spatialization plugin *
+ *                                                                        *
+ * ControlGris is free software: you can redistribute it and/or modify    *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * ControlGris is distributed in the hope that it will be useful,         *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with ControlGris.  If not, see                           *
+ * <http://www.gnu.org/licenses/>.                                        *
+ *************************************************************************/
+#pragma once
+
+#include <atomic>
+#ifndef CONTROLGRIS_STANDALONE
+ #include "../JuceLibraryCode/JuceHeader.h"
+#endif
+#include "ControlGrisConstants.h"
+#include "Source.h"
+
+// Copy of the state of a source, as published for the other threads.
+struct SourceFrame
+{
+    int id;
+    float azimuth;
+    float elevation;
+    float distance;
+    float x;
+    float y;
+    float azimuthSpan;
+    float elevationSpan;
+
+    // Incremented every time the source has changed.
+    uint32 version;
+
+    float getNormalizedAzimuth() const;
+    float getNormalizedElevation() const;
+};
+
+// Publishes snapshots of the sources written by a single thread (the message
+// thread) to any number of readers. The writer fills the inactive of two
+// buffers and then makes it current. Each buffer is protected by a sequence
+// counter, so readers never wait and only retry if the writer went through
+// both buffers during their copy.
+class SourceFrameBuffer
+{
+public:
+    SourceFrameBuffer();
+    ~SourceFrameBuffer();
+
+    // Writer only.
+    void publish(Source* sources, int numberOfSources);
+
+    // Copies the active frames of the current snapshot in dest (room for
+    // MAX_NUMBER_OF_SOURCES frames) and returns the number of active sources.
+    int read(SourceFrame* dest) const;
+
+private:
+    struct Snapshot
+    {
+        std::atomic<uint32> sequence;
+        int numberOfSources;
+        SourceFrame frames[MAX_NUMBER_OF_SOURCES];
+    };
+
+    Snapshot snapshots[2];
+    std::atomic<int> current;
+
+    uint32 versions[MAX_NUMBER_OF_SOURCES];
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SourceFrameBuffer)
+};
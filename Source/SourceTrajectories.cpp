@@ -0,0 +1,120 @@
+/**************************************************************************
+ * Copyright 2018 UdeM - GRIS - Olivier Belanger                          *
+ *                                                                        *
+ * This file is part of ControlGris, a multi-source spatialization plugin *
+ *                                                                        *
+ * ControlGris is free software: you can redistribute it and/or modify    *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * ControlGris is distributed in the hope that it will be useful,         *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with ControlGris.  If not, see                           *
+ * <http://www.gnu.org/licenses/>.                                        *
+ *************************************************************************/
+#include "SourceTrajectories.h"
+
+SourceTrajectories::SourceTrajectories(int capacity)
+    : capacity (capacity),
+      period (capacity),
+      phaseOffset (capacity, true),
+      positionX (capacity, true),
+      positionY (capacity, true)
+{
+    for (int i = 0; i < capacity; i++) {
+        shapes.add(TrajectoryShape());
+        period[i] = 5.0;
+    }
+    hasPublishedPositions = false;
+}
+
+SourceTrajectories::~SourceTrajectories() {}
+
+void SourceTrajectories::setTrajectory(int index, const TrajectoryShape& shape) {
+    jassert (isPositiveAndBelow(index, capacity));
+
+    const ScopedLock lock (trajectoryLock);
+    shapes.set(index, shape);
+    Point<float> start = shape.getPosition(0.0);
+    positionX[index] = start.x;
+    positionY[index] = start.y;
+}
+
+void SourceTrajectories::clearTrajectory(int index) {
+    jassert (isPositiveAndBelow(index, capacity));
+
+    const ScopedLock lock (trajectoryLock);
+    shapes.set(index, TrajectoryShape());
+}
+
+bool SourceTrajectories::hasTrajectory(int index) const {
+    return shapes.getReference(index).isValid();
+}
+
+int SourceTrajectories::getDrawingType(int index) const {
+    return shapes.getReference(index).getDrawingType();
+}
+
+void SourceTrajectories::setPeriod(int index, double seconds) {
+    const ScopedLock lock (trajectoryLock);
+    period[index] = jmax(seconds, 0.01);
+}
+
+double SourceTrajectories::getPeriod(int index) const {
+    return period[index];
+}
+
+void SourceTrajectories::setPhaseOffset(int index, double phase) {
+    const ScopedLock lock (trajectoryLock);
+    phaseOffset[index] = phase - std::floor(phase);
+}
+
+double SourceTrajectories::getPhaseOffset(int index) const {
+    return phaseOffset[index];
+}
+
+void SourceTrajectories::computePositions(double relativeTimeFromPlay) {
+    const ScopedTryLock lock (trajectoryLock);
+    if (! lock.isLocked()) {
+        return;
+    }
+
+    for (int i = 0; i < capacity; i++) {
+        const TrajectoryShape& shape = shapes.getReference(i);
+        if (! shape.isValid()) {
+            continue;
+        }
+
+        double phase = relativeTimeFromPlay / period[i] + phaseOffset[i];
+        Point<float> position = shape.getPosition(phase - std::floor(phase));
+        positionX[i] = position.x;
+        positionY[i] = position.y;
+    }
+
+    hasPublishedPositions = true;
+}
+
+int SourceTrajectories::applyPositions(SourceBank& bank, int numSources) {
+    if (! hasPublishedPositions.exchange(false)) {
+        return 0;
+    }
+
+    const ScopedLock lock (trajectoryLock);
+    int numMoved = 0;
+    numSources = jmin(numSources, capacity, bank.getCapacity());
+    for (int i = 0; i < numSources; i++) {
+        if (shapes.getReference(i).isValid()) {
+            bank.x[i] = positionX[i];
+            bank.y[i] = positionY[i];
+            bank.cartesianOutdated[i] = false;
+            bank.setCartesianChanged(i);
+            numMoved++;
+        }
+    }
+    return numMoved;
+}
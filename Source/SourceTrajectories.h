@@ -0,0 +1,80 @@
+/**************************************************************************
+ * Copyright 2018 UdeM - GRIS - Olivier Belanger                          *
+ *                                                                        *
+ * This file is part of ControlGris, a multi-source spatialization plugin *
+ *                                                                        *
+ * ControlGris is free software: you can redistribute it and/or modify    *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * ControlGris is distributed in the hope that it will be useful,         *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with ControlGris.  If not, see                           *
+ * <http://www.gnu.org/licenses/>.                                        *
+ *************************************************************************/
+#pragma once
+
+#include <atomic>
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "SourceBank.h"
+#include "TrajectoryShape.h"
+
+// Independent trajectories of the sources. Each source can follow its own
+// trajectory, with its own period and phase offset, instead of following the
+// first source through the link modes.
+//
+// All the trajectories are evaluated together on the audio thread, from the
+// host clock. The resulting positions are written to the source bank in a
+// single pass on the message thread, without any listener callback.
+//
+// The trajectories are generated shapes, evaluated in closed form. Their periods
+// are in seconds only: they do not follow the tempo, even when the main trajectory
+// is synced to beats or bars.
+class SourceTrajectories
+{
+public:
+    explicit SourceTrajectories(int capacity);
+    ~SourceTrajectories();
+
+    // Message thread.
+    void setTrajectory(int index, const TrajectoryShape& shape);
+    void clearTrajectory(int index);
+    bool hasTrajectory(int index) const;
+    int getDrawingType(int index) const;
+
+    void setPeriod(int index, double seconds);
+    double getPeriod(int index) const;
+
+    // Fraction of the period, wrapped to [0, 1).
+    void setPhaseOffset(int index, double phase);
+    double getPhaseOffset(int index) const;
+
+    // Audio thread. Evaluates every trajectory at the time elapsed since the start of playback.
+    void computePositions(double relativeTimeFromPlay);
+
+    // Message thread. Moves the first numSources sources of the bank to their last
+    // computed position. Returns the number of sources moved.
+    int applyPositions(SourceBank& bank, int numSources);
+
+private:
+    int capacity;
+
+    Array<TrajectoryShape> shapes;
+    HeapBlock<double> period;
+    HeapBlock<double> phaseOffset;
+
+    // Last positions computed on the audio thread.
+    HeapBlock<float> positionX;
+    HeapBlock<float> positionY;
+    std::atomic<bool> hasPublishedPositions;
+
+    // Protects the trajectories and the computed positions.
+    CriticalSection trajectoryLock;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SourceTrajectories)
+};
@@ -0,0 +1,89 @@
+/**************************************************************************
+ * Copyright 2018 UdeM - GRIS - Olivier Belanger                          *
+ *                                                                        *
+ * This file is part of ControlGris, a multi-source spatialization plugin *
+ *                                                                        *
+ * ControlGris is free software: you can redistribute it and/or modify    *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * ControlGris is distributed in the hope that it will be useful,         *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with ControlGris.  If not, see                           *
+ * <http://www.gnu.org/licenses/>.                                        *
+ *************************************************************************/
+#include "SpatServEncoder.h"
+
+SpatServEncoder::SpatServEncoder() {
+    writeMessageTemplate(messageBuffer);
+
+    // The bundle is laid out for the largest datagram size.
+    maxNumBundleMessages = (MAX_OSC_MAX_DATAGRAM_SIZE - kBundleHeaderSize) / (kBundleElementHeaderSize + kMessageSize);
+    bundleBuffer.calloc(getBundleSize(maxNumBundleMessages));
+
+    // "#bundle", followed by the "immediately" time tag.
+    memcpy(bundleBuffer.get(), "#bundle", 8);
+    writeInt32(bundleBuffer.get() + 8, 0);
+    writeInt32(bundleBuffer.get() + 12, 1);
+
+    for (int i = 0; i < maxNumBundleMessages; i++) {
+        char *element = bundleBuffer.get() + getBundleSize(i);
+        writeInt32(element, kMessageSize);
+        writeMessageTemplate(element + kBundleElementHeaderSize);
+    }
+}
+
+SpatServEncoder::~SpatServEncoder() {}
+
+const char* SpatServEncoder::encodeMessage(const SpatServFrame& frame) {
+    writeArguments(messageBuffer, frame);
+    return messageBuffer;
+}
+
+void SpatServEncoder::setBundleMessage(int index, const SpatServFrame& frame) {
+    jassert(index >= 0 && index < maxNumBundleMessages);
+    writeArguments(bundleBuffer.get() + getBundleSize(index) + kBundleElementHeaderSize, frame);
+}
+
+const char* SpatServEncoder::getBundleData() const {
+    return bundleBuffer.get();
+}
+
+int SpatServEncoder::getMaxNumBundleMessages(int maxDatagramSize) const {
+    int numMessages = (maxDatagramSize - kBundleHeaderSize) / (kBundleElementHeaderSize + kMessageSize);
+    return jlimit(1, maxNumBundleMessages, numMessages);
+}
+
+int SpatServEncoder::getBundleSize(int numMessages) {
+    return kBundleHeaderSize + numMessages * (kBundleElementHeaderSize + kMessageSize);
+}
+
+void SpatServEncoder::writeMessageTemplate(char* dest) {
+    memset(dest, 0, kMessageSize);
+    // Strings are null terminated and padded to a multiple of 4 bytes.
+    memcpy(dest, "/spat/serv", 10);
+    memcpy(dest + 12, ",iffffff", 8);
+}
+
+void SpatServEncoder::writeArguments(char* message, const SpatServFrame& frame) {
+    const float values[6] = { frame.azimuth, frame.elevation, frame.azimuthSpan,
+                              frame.elevationSpan, frame.distance, 0.f };
+
+    char *dest = message + kArgumentsOffset;
+    writeInt32(dest, (uint32)frame.sourceId);
+    for (int i = 0; i < 6; i++) {
+        uint32 bits;
+        memcpy(&bits, &values[i], 4);
+        writeInt32(dest + 4 * (i + 1), bits);
+    }
+}
+
+void SpatServEncoder::writeInt32(char* dest, uint32 value) {
+    value = ByteOrder::swapIfLittleEndian(value);
+    memcpy(dest, &value, 4);
+}
@@ -0,0 +1,81 @@
+/**************************************************************************
+ * Copyright 2018 UdeM - GRIS - Olivier Belanger                          *
+ *                                                                        *
+ * This file is part of ControlGris, a multi-source spatialization plugin *
+ *                                                                        *
+ * ControlGris is free software: you can redistribute it and/or modify    *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * ControlGris is distributed in the hope that it will be useful,         *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with ControlGris.  If not, see                           *
+ * <http://www.gnu.org/licenses/>.                                        *
+ *************************************************************************/
+#pragma once
+
+#ifndef CONTROLGRIS_STANDALONE
+ #include "../JuceLibraryCode/JuceHeader.h"
+#endif
+#include "ControlGrisConstants.h"
+
+// One /spat/serv message, with values already converted to the server's units.
+struct SpatServFrame
+{
+    int sourceId;
+    float azimuth;
+    float elevation;
+    float azimuthSpan;
+    float elevationSpan;
+    float distance;
+};
+
+// Encodes /spat/serv messages directly in preallocated datagram buffers.
+//
+// The address pattern, the type tags and the bundle headers are written once,
+// when the encoder is created. Encoding a frame only patches the big-endian
+// argument slots of its message, so nothing is allocated while sending.
+class SpatServEncoder
+{
+public:
+    SpatServEncoder();
+    ~SpatServEncoder();
+
+    // Single message datagram, valid until the next call.
+    const char* encodeMessage(const SpatServFrame& frame);
+
+    // Bundle datagram, made of the first numMessages messages set with setBundleMessage().
+    void setBundleMessage(int index, const SpatServFrame& frame);
+    const char* getBundleData() const;
+
+    int getMaxNumBundleMessages(int maxDatagramSize) const;
+
+    static int getBundleSize(int numMessages);
+
+    // Encoded sizes, in bytes, of a /spat/serv message ("/spat/serv", ",iffffff"
+    // and 7 arguments), of a bundle header ("#bundle" and time tag) and of the
+    // size prefix of each bundle element.
+    static const int kMessageSize = 52;
+    static const int kBundleHeaderSize = 16;
+    static const int kBundleElementHeaderSize = 4;
+
+private:
+    static void writeMessageTemplate(char* dest);
+    static void writeArguments(char* message, const SpatServFrame& frame);
+    static void writeInt32(char* dest, uint32 value);
+
+    // Offset of the first argument in a message.
+    static const int kArgumentsOffset = 24;
+
+    char messageBuffer[kMessageSize];
+
+    HeapBlock<char> bundleBuffer;
+    int maxNumBundleMessages;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SpatServEncoder)
+};
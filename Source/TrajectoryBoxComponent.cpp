@@ -68,12 +68,27 @@ TrajectoryBoxComponent::TrajectoryBoxComponent() {
             durationUnitCombo.grabKeyboardFocus(); };
 
     addAndMakeVisible(&durationUnitCombo);
-    durationUnitCombo.addItem("Sec(s)", 1);
-    durationUnitCombo.addItem("Beat(s)", 2);
-    durationUnitCombo.setSelectedId(1);
+    durationUnitCombo.addItem("Sec(s)", DURATION_UNIT_SECONDS);
+    durationUnitCombo.addItem("Beat(s)", DURATION_UNIT_BEATS);
+    durationUnitCombo.addItem("Bar(s)", DURATION_UNIT_BARS);
+    durationUnitCombo.setSelectedId(DURATION_UNIT_SECONDS);
     durationUnitCombo.onChange = [this] { 
             listeners.call([&] (Listener& l) { l.trajectoryBoxDurationUnitChanged(durationEditor.getText().getDoubleValue(), durationUnitCombo.getSelectedId()); }); };
 
+    constantSpeedToggle.setButtonText("Constant Speed");
+    constantSpeedToggle.setToggleState(false, NotificationType::dontSendNotification);
+    constantSpeedToggle.onClick = [this] {
+            listeners.call([&] (Listener& l) { l.trajectoryBoxConstantSpeedChanged(constantSpeedToggle.getToggleState()); });
+        };
+    addAndMakeVisible(&constantSpeedToggle);
+
+    recordedTimingToggle.setButtonText("Recorded Timing");
+    recordedTimingToggle.setToggleState(false, NotificationType::dontSendNotification);
+    recordedTimingToggle.onClick = [this] {
+            listeners.call([&] (Listener& l) { l.trajectoryBoxRecordedTimingChanged(recordedTimingToggle.getToggleState()); });
+        };
+    addAndMakeVisible(&recordedTimingToggle);
+
     cycleSpeedLabel.setText("Cycle Speed:", NotificationType::dontSendNotification);
     addAndMakeVisible(&cycleSpeedLabel);
 
@@ -235,6 +250,14 @@ void TrajectoryBoxComponent::setDeviationPerCycle(float value) {
     deviationEditor.setText(String(value));
 }
 
+void TrajectoryBoxComponent::setConstantSpeed(bool state) {
+    constantSpeedToggle.setToggleState(state, NotificationType::sendNotificationAsync);
+}
+
+void TrajectoryBoxComponent::setRecordedTiming(bool state) {
+    recordedTimingToggle.setToggleState(state, NotificationType::sendNotificationAsync);
+}
+
 void TrajectoryBoxComponent::setSourceLink(int value) {
     sourceLinkCombo.setSelectedId(value);
 }
@@ -309,6 +332,8 @@ void TrajectoryBoxComponent::resized() {
     durationLabel.setBounds(490, 15, 90, 20);
     durationEditor.setBounds(495, 40, 90, 20);
     durationUnitCombo.setBounds(495, 70, 90, 20);
+    constantSpeedToggle.setBounds(495, 100, 120, 20);
+    recordedTimingToggle.setBounds(495, 130, 120, 20);
 
     // Hide Cycle Speed slider until we found the good way to handle it!
     cycleSpeedLabel.setBounds(5, 100, 150, 20);
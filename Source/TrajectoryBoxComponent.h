@@ -47,6 +47,8 @@ public:
     void setCycleDuration(double value);
     void setDurationUnit(int value);
     void setDeviationPerCycle(float value);
+    void setConstantSpeed(bool state);
+    void setRecordedTiming(bool state);
 
     bool getActivateState();
     bool getActivateAltState();
@@ -66,6 +68,8 @@ public:
         virtual void trajectoryBoxDampeningCyclesChanged(int value) = 0;
         virtual void trajectoryBoxDampeningCyclesAltChanged(int value) = 0;
         virtual void trajectoryBoxDeviationPerCycleChanged(float value) = 0;
+        virtual void trajectoryBoxConstantSpeedChanged(bool value) = 0;
+        virtual void trajectoryBoxRecordedTimingChanged(bool value) = 0;
         virtual void trajectoryBoxCycleDurationChanged(double duration, int mode) = 0;
         virtual void trajectoryBoxDurationUnitChanged(double duration, int mode) = 0;
         virtual void trajectoryBoxActivateChanged(bool value) = 0;
@@ -103,6 +107,9 @@ private:
     TextEditor      durationEditor;
     ComboBox        durationUnitCombo;
 
+    ToggleButton    constantSpeedToggle;
+    ToggleButton    recordedTimingToggle;
+
     Label           cycleSpeedLabel;
     Slider          cycleSpeedSlider;
 
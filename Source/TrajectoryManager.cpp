@@ -0,0 +1,429 @@
+/**************************************************************************
+ * Copyright 2018 UdeM - GRIS - Olivier Belanger                          *
+ *                                                                        *
+ * This file is part of ControlGris, a multi-source spatialization plugin *
+ *                                                                        *
+ * ControlGris is free software: you can redistribute it and/or modify    *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * ControlGris is distributed in the hope that it will be useful,         *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with ControlGris.  If not, see                           *
+ * <http://www.gnu.org/licenses/>.                                        *
+ *************************************************************************/
+#include "TrajectoryManager.h"
+#include "AutomationManager.h"
+#include "ControlGrisMath.h"
+
+// Number of steps of a generated shape, used for its arc-length table.
+static const int kNumberOfShapeSamples = 256;
+
+// Minimum number of steps between two knots of a spline.
+static const int kNumberOfSplineSamplesPerPoint = 8;
+
+// x in the low 32 bits, y in the high 32 bits.
+static uint64 packPosition(float x, float y) {
+    uint32 bitsX, bitsY;
+    memcpy(&bitsX, &x, 4);
+    memcpy(&bitsY, &y, 4);
+    return (uint64)bitsX | ((uint64)bitsY << 32);
+}
+
+static Point<float> unpackPosition(uint64 packed) {
+    uint32 bitsX = (uint32)packed;
+    uint32 bitsY = (uint32)(packed >> 32);
+    Point<float> position;
+    memcpy(&position.x, &bitsX, 4);
+    memcpy(&position.y, &bitsY, 4);
+    return position;
+}
+
+static Point<float> interpolatePoints(const Array<Point<float>>& points, double phase) {
+    int size = points.size();
+    if (size == 0) {
+        return Point<float> ();
+    }
+
+    double delta = phase * (size - 1);
+    int index = jlimit(0, size - 1, (int)delta);
+    if (index + 1 < size) {
+        float frac = (float)(delta - index);
+        Point<float> p1 = points.getReference(index);
+        Point<float> p2 = points.getReference(index + 1);
+        return Point<float> (p1.x + (p2.x - p1.x) * frac, p1.y + (p2.y - p1.y) * frac);
+    }
+    return points.getLast();
+}
+
+TrajectoryManager::TrajectoryManager() {
+    for (int i = 0; i < NUMBER_OF_AXES; i++) {
+        views[i] = nullptr;
+        viewRevisions[i] = -1;
+        hasPoints[i] = false;
+        activateStates[i] = false;
+        publishedPositions[i] = packPosition(0.0f, 0.0f);
+        hasPublishedPosition[i] = false;
+    }
+    numberOfSamples = 0;
+    isConstantSpeed = false;
+    isRecordedTiming = false;
+    isBackAndForth = false;
+    dampeningCycles = 0;
+    degreeOfDeviationPerCycle = 0.0f;
+    playbackDuration = 5.0;
+    playbackDurationUnit = DURATION_UNIT_SECONDS;
+    resetPlayback();
+}
+
+TrajectoryManager::~TrajectoryManager() {}
+
+void TrajectoryManager::setView(int axis, AutomationManager* view) {
+    views[axis] = view;
+    viewRevisions[axis] = -1;
+}
+
+void TrajectoryManager::resetPlayback() {
+    trajectoryDeltaTime = lastTrajectoryDeltaTime = 0.0;
+    backAndForthDirection = 0;
+    dampeningCycleCount = 0;
+    dampeningLastDelta = 0.0;
+    currentPlaybackDuration = playbackDuration;
+    currentDegreeOfDeviation = 0.0f;
+    deviationCycleCount = 0;
+}
+
+void TrajectoryManager::setActivateState(int axis, bool state) {
+    const ScopedLock lock (playbackLock);
+    bool wasPlaying = activateStates[AXIS_XY] || activateStates[AXIS_Z];
+    activateStates[axis] = state;
+    hasPublishedPosition[axis] = false;
+    // An axis activated while the other one is playing joins it in phase.
+    if (state && ! wasPlaying) {
+        resetPlayback();
+    }
+}
+
+bool TrajectoryManager::getActivateState(int axis) const {
+    return activateStates[axis];
+}
+
+void TrajectoryManager::setPlaybackDuration(double value, int unit) {
+    const ScopedLock lock (playbackLock);
+    playbackDuration = value;
+    playbackDurationUnit = unit;
+}
+
+double TrajectoryManager::getPlaybackDuration() const {
+    return playbackDuration;
+}
+
+int TrajectoryManager::getPlaybackDurationUnit() const {
+    return playbackDurationUnit;
+}
+
+void TrajectoryManager::setBackAndForth(bool shouldBeOn) {
+    const ScopedLock lock (playbackLock);
+    isBackAndForth = shouldBeOn;
+}
+
+void TrajectoryManager::setDampeningCycles(int value) {
+    const ScopedLock lock (playbackLock);
+    dampeningCycles = value;
+}
+
+void TrajectoryManager::setDeviationPerCycle(float value) {
+    const ScopedLock lock (playbackLock);
+    degreeOfDeviationPerCycle = value;
+}
+
+void TrajectoryManager::setConstantSpeed(bool shouldBeOn) {
+    const ScopedLock lock (playbackLock);
+    isConstantSpeed = shouldBeOn;
+}
+
+bool TrajectoryManager::getConstantSpeed() const {
+    return isConstantSpeed;
+}
+
+void TrajectoryManager::setRecordedTiming(bool shouldBeOn) {
+    const ScopedLock lock (playbackLock);
+    isRecordedTiming = shouldBeOn;
+}
+
+bool TrajectoryManager::getRecordedTiming() const {
+    return isRecordedTiming;
+}
+
+void TrajectoryManager::updateSamples() {
+    bool changed = false;
+    for (int axis = 0; axis < NUMBER_OF_AXES; axis++) {
+        // A drawing in progress is picked up when it is finished, the previous trajectory plays until then.
+        if (views[axis] != nullptr && views[axis]->getTrajectoryRevision() != viewRevisions[axis]
+            && ! views[axis]->isRecordingTrajectory()) {
+            viewRevisions[axis] = views[axis]->getTrajectoryRevision();
+            viewShapes[axis] = views[axis]->getTrajectoryShape();
+            viewSplines[axis] = views[axis]->getTrajectorySpline();
+            // Shapes and splines are evaluated when played.
+            if (viewShapes[axis].isValid() || viewSplines[axis].isValid()) {
+                viewPoints[axis].clearQuick();
+            } else {
+                views[axis]->getNormalizedTrajectoryPoints(viewPoints[axis]);
+            }
+            changed = true;
+        }
+    }
+
+    if (! changed) {
+        return;
+    }
+
+    // The clock has the resolution of the finest part.
+    const ScopedLock lock (playbackLock);
+    numberOfSamples = 0;
+    for (int axis = 0; axis < NUMBER_OF_AXES; axis++) {
+        points[axis] = viewPoints[axis];
+        shapes[axis] = viewShapes[axis];
+        splines[axis] = viewSplines[axis];
+        hasPoints[axis] = getNumberOfSteps(axis) > 0;
+        numberOfSamples = jmax(numberOfSamples, getNumberOfSteps(axis));
+        hasPublishedPosition[axis] = false;
+    }
+
+    // Each part has its own length, and the elevation drawing goes along the time.
+    computeArcLengths(AXIS_XY);
+    arcLengths[AXIS_Z].clearQuick();
+}
+
+int TrajectoryManager::getNumberOfSteps(int axis) const {
+    if (shapes[axis].isValid()) {
+        return kNumberOfShapeSamples;
+    } else if (splines[axis].isValid()) {
+        return jmax(kNumberOfShapeSamples, splines[axis].getNumberOfPoints() * kNumberOfSplineSamplesPerPoint);
+    }
+    return points[axis].size();
+}
+
+// Leaves the table empty when the part doesn't move.
+void TrajectoryManager::computeArcLengths(int axis) {
+    Array<float>& lengths = arcLengths[axis];
+    int size = getNumberOfSteps(axis);
+    lengths.clearQuick();
+    lengths.ensureStorageAllocated(size);
+    float length = 0.0f;
+    Point<float> previous;
+    for (int i = 0; i < size; i++) {
+        Point<float> position = getAxisPosition(axis, size > 1 ? i / (size - 1.0) : 0.0);
+        if (i > 0) {
+            length += previous.getDistanceFrom(position);
+        }
+        lengths.add(length);
+        previous = position;
+    }
+    if (length > 0.0f) {
+        for (auto &l : lengths)
+            l /= length;
+    } else {
+        lengths.clearQuick();
+    }
+}
+
+void TrajectoryManager::computeTrajectoryPosition(double relativeTimeFromPlay, double ppqPosition, double quarterNotesPerBar) {
+    const ScopedTryLock lock (playbackLock);
+    if (! lock.isLocked() || numberOfSamples == 0) {
+        return;
+    }
+
+    bool isPlaying[NUMBER_OF_AXES];
+    for (int axis = 0; axis < NUMBER_OF_AXES; axis++) {
+        isPlaying[axis] = activateStates[axis] && hasPoints[axis];
+    }
+    if (! isPlaying[AXIS_XY] && ! isPlaying[AXIS_Z]) {
+        return;
+    }
+
+    if (playbackDurationUnit == DURATION_UNIT_SECONDS) {
+        trajectoryDeltaTime = relativeTimeFromPlay / currentPlaybackDuration;
+        trajectoryDeltaTime = std::fmod(trajectoryDeltaTime, 1.0);
+    } else {
+        setCycleFromPpq(ppqPosition, quarterNotesPerBar);
+    }
+
+    Sample sample;
+    computeCurrentSample(sample);
+
+    if (isPlaying[AXIS_XY]) {
+        publishedPositions[AXIS_XY] = packPosition(sample.x, sample.y);
+        hasPublishedPosition[AXIS_XY] = true;
+    }
+    if (isPlaying[AXIS_Z]) {
+        publishedPositions[AXIS_Z] = packPosition(sample.zx, sample.z);
+        hasPublishedPosition[AXIS_Z] = true;
+    }
+}
+
+// The phase and the cycle count are a function of the host position only, so the same
+// position always plays the same point of the trajectory.
+void TrajectoryManager::setCycleFromPpq(double ppqPosition, double quarterNotesPerBar) {
+    double cycleLength = playbackDuration;
+    if (playbackDurationUnit == DURATION_UNIT_BARS) {
+        cycleLength *= quarterNotesPerBar;
+    }
+    if (cycleLength <= 0.0) {
+        return;
+    }
+
+    double cycles = jmax(0.0, ppqPosition) / cycleLength;
+    int cycleCount = (int)std::floor(cycles);
+    trajectoryDeltaTime = cycles - cycleCount;
+
+    // Set here instead of being counted in computeCurrentSample.
+    lastTrajectoryDeltaTime = 0.0;
+    backAndForthDirection = isBackAndForth ? cycleCount % 2 : 0;
+    dampeningCycleCount = isBackAndForth ? jmin(cycleCount, dampeningCycles * 2) : 0;
+    deviationCycleCount = cycleCount;
+}
+
+void TrajectoryManager::computeCurrentSample(Sample& sample) {
+    int numSamples = numberOfSamples;
+    int dampeningCyclesTimes2 = dampeningCycles * 2;
+    double currentScaleMin = 0.0, currentScaleMax = 0.0;
+
+    if (trajectoryDeltaTime < lastTrajectoryDeltaTime) {
+        if (isBackAndForth) {
+            backAndForthDirection = 1 - backAndForthDirection;
+            dampeningCycleCount++;
+            if (dampeningCycleCount >= dampeningCyclesTimes2)
+                dampeningCycleCount = dampeningCyclesTimes2;
+        }
+        deviationCycleCount++;
+    }
+    lastTrajectoryDeltaTime = trajectoryDeltaTime;
+
+    double trajectoryPhase;
+    if (isBackAndForth && dampeningCycles > 0) {
+        if (trajectoryDeltaTime <= 0.5) {
+            trajectoryPhase = pow(trajectoryDeltaTime * 2.0, 2.0) * 0.5;
+        } else {
+            trajectoryPhase = 1.0 - pow(1.0 - ((trajectoryDeltaTime - 0.5) * 2.0), 2.0) * 0.5;
+        }
+    } else {
+        trajectoryPhase = trajectoryDeltaTime;
+    }
+
+    double delta = trajectoryPhase * numSamples;
+
+    if (backAndForthDirection == 1)
+        delta = numSamples - delta;
+
+    if (delta + 1 >= numSamples) {
+        delta = numSamples;
+    } else if (delta < 0) {
+        delta = 0;
+    }
+
+    if (isBackAndForth && dampeningCycles > 0) {
+        if (dampeningCycleCount < dampeningCyclesTimes2) {
+            double relativeDeltaTime = (dampeningCycleCount + trajectoryDeltaTime) / dampeningCyclesTimes2;
+            currentPlaybackDuration = playbackDuration - (pow(relativeDeltaTime, 2.0) * playbackDuration * 0.25);
+            currentScaleMin = relativeDeltaTime * numSamples * 0.5;
+            currentScaleMax = numSamples - currentScaleMin;
+            double currentScale = (currentScaleMax - currentScaleMin) / numSamples;
+            dampeningLastDelta = delta = delta * currentScale + currentScaleMin;
+        } else {
+            delta = dampeningLastDelta;
+        }
+    } else {
+        dampeningLastDelta = delta;
+    }
+
+    double deltaRatio = static_cast<double> (numSamples - 1) / numSamples;
+    delta *= deltaRatio;
+
+    double phase = numSamples > 1 ? delta / (numSamples - 1) : 0.0;
+    Point<float> xy = evaluateAxis(AXIS_XY, phase);
+    sample.x = xy.x;
+    sample.y = xy.y;
+    Point<float> z = evaluateAxis(AXIS_Z, phase);
+    sample.zx = z.x;
+    sample.z = z.y;
+
+    // The deviation only rotates the main field part of the trajectory.
+    if (degreeOfDeviationPerCycle != 0) {
+        bool deviationFlag = true;
+        if (isBackAndForth && dampeningCycles > 0) {
+            if (approximatelyEqual(currentScaleMin, currentScaleMax)) {
+                deviationFlag = false;
+            }
+        }
+        if (deviationFlag) {
+            currentDegreeOfDeviation = (deviationCycleCount + trajectoryDeltaTime) * degreeOfDeviationPerCycle;
+            currentDegreeOfDeviation = std::fmod(currentDegreeOfDeviation, 360.0f);
+        }
+        // Same rotation as in the field, where y goes down.
+        float angle = -currentDegreeOfDeviation / 360.0f * 2.0f * kMathPi;
+        float s = fastSin(angle), c = fastCos(angle);
+        float x = sample.x - 0.5f, y = sample.y - 0.5f;
+        sample.x = x * c - y * s + 0.5f;
+        sample.y = x * s + y * c + 0.5f;
+    }
+}
+
+// Converts a phase, taken as a fraction of the length of one part, to the phase where
+// that distance is reached. Parts without an arc-length table keep the phase.
+double TrajectoryManager::mapToArcLength(int axis, double phase) const {
+    const Array<float>& lengths = arcLengths[axis];
+    int numLengths = lengths.size();
+    if (numLengths < 2) {
+        return phase;
+    }
+
+    float target = (float)phase;
+    const float *begin = lengths.begin();
+    const float *end = lengths.end();
+    int index = (int)(std::upper_bound(begin, end, target) - begin) - 1;
+    index = jlimit(0, numLengths - 2, index);
+
+    float segment = begin[index + 1] - begin[index];
+    float frac = segment > 0.0f ? (target - begin[index]) / segment : 0.0f;
+    return (index + jlimit(0.0f, 1.0f, frac)) / (numLengths - 1);
+}
+
+// Position of one part of the trajectory at the phase of the clock. The recorded
+// timing of a drawn part overrides its constant speed.
+Point<float> TrajectoryManager::evaluateAxis(int axis, double phase) const {
+    if (isRecordedTiming && splines[axis].hasTimes()) {
+        phase = splines[axis].getPhaseAtTime(phase);
+    } else if (isConstantSpeed) {
+        phase = mapToArcLength(axis, phase);
+    }
+    return getAxisPosition(axis, phase);
+}
+
+// Position of one part at a phase of its shape, spline or points.
+Point<float> TrajectoryManager::getAxisPosition(int axis, double phase) const {
+    if (shapes[axis].isValid()) {
+        return shapes[axis].getPosition(phase);
+    } else if (splines[axis].isValid()) {
+        return splines[axis].getPosition(phase);
+    }
+    return interpolatePoints(points[axis], phase);
+}
+
+bool TrajectoryManager::takePublishedPosition(int axis, Point<float>& position) {
+    if (! activateStates[axis] || ! hasPublishedPosition[axis].exchange(false)) {
+        return false;
+    }
+
+    position = getPublishedPosition(axis);
+    return true;
+}
+
+Point<float> TrajectoryManager::getPublishedPosition(int axis) const {
+    return unpackPosition(publishedPositions[axis]);
+}
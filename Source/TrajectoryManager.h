@@ -0,0 +1,162 @@
+/**************************************************************************
+ * Copyright 2018 UdeM - GRIS - Olivier Belanger                          *
+ *                                                                        *
+ * This file is part of ControlGris, a multi-source spatialization plugin *
+ *                                                                        *
+ * ControlGris is free software: you can redistribute it and/or modify    *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * ControlGris is distributed in the hope that it will be useful,         *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with ControlGris.  If not, see                           *
+ * <http://www.gnu.org/licenses/>.                                        *
+ *************************************************************************/
+#pragma once
+
+#include <atomic>
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "TrajectoryShape.h"
+#include "TrajectorySpline.h"
+#include "ControlGrisConstants.h"
+
+class AutomationManager;
+
+// Playback of the trajectory of the main field (x, y) and of the elevation
+// field (z) as a single 3D trajectory.
+//
+// The two AutomationManager objects are the views used to draw or generate
+// each part of the trajectory. Both parts share a single clock and a single
+// back and forth, dampening and deviation state, and are evaluated with one
+// phase computation. Generated shapes, and the splines fitted to the drawn
+// trajectories, are evaluated at that phase. They are only sampled to measure
+// the length of the main field part.
+//
+// With constant speed, the phase of the main field part is mapped to the
+// distance travelled in the field. The x axis of the elevation drawing is the
+// time, so the phase of that part stays mapped to its point index.
+//
+// Drawn trajectories also keep the time at which each knot of their spline was
+// recorded. With recorded timing, the phase of the cycle is mapped to these
+// times, so the trajectory is played with the speed at which it was drawn.
+//
+// A cycle lasts a number of seconds, beats or bars. In beats and bars, the phase
+// and the cycle count come from the host position, so the trajectory stays
+// locked to the bars through tempo changes and looped regions.
+class TrajectoryManager
+{
+public:
+    enum Axis { AXIS_XY = 0, AXIS_Z, NUMBER_OF_AXES };
+
+    // Normalized source coordinates (0 to 1, y up).
+    struct Sample
+    {
+        float x;
+        float y;
+        float z;
+        // Horizontal position of the handle in the elevation field.
+        float zx;
+    };
+
+    TrajectoryManager();
+    ~TrajectoryManager();
+
+    void setView(int axis, AutomationManager* view);
+
+    void setActivateState(int axis, bool state);
+    bool getActivateState(int axis) const;
+
+    // unit is one of DURATION_UNIT_ENUM.
+    void setPlaybackDuration(double value, int unit = DURATION_UNIT_SECONDS);
+    double getPlaybackDuration() const;
+    int getPlaybackDurationUnit() const;
+
+    void setBackAndForth(bool shouldBeOn);
+    void setDampeningCycles(int value);
+    void setDeviationPerCycle(float value);
+
+    // With constant speed, the phase of the main field part is mapped to the distance
+    // travelled along it. Otherwise it is mapped to the point index, and the speed
+    // depends on the spacing of the points (legacy timing). Off by default.
+    void setConstantSpeed(bool shouldBeOn);
+    bool getConstantSpeed() const;
+
+    // With recorded timing, drawn trajectories are played with the timing of the drawing,
+    // scaled to the cycle duration. It overrides the constant speed.
+    void setRecordedTiming(bool shouldBeOn);
+    bool getRecordedTiming() const;
+
+    // Called on the message thread. Rebuilds the samples if the points of a view have changed.
+    void updateSamples();
+
+    // Called on the audio thread with the time elapsed since the start of playback, and
+    // the host position in quarter notes with the length of a bar in quarter notes.
+    void computeTrajectoryPosition(double relativeTimeFromPlay, double ppqPosition, double quarterNotesPerBar);
+
+    // Called on the message thread. Returns true if a new position was computed for the
+    // axis since the last call. Positions are the ones of the source of the view.
+    bool takePublishedPosition(int axis, Point<float>& position);
+    Point<float> getPublishedPosition(int axis) const;
+
+private:
+    AutomationManager *views[NUMBER_OF_AXES];
+    int viewRevisions[NUMBER_OF_AXES];
+    Array<Point<float>> viewPoints[NUMBER_OF_AXES];
+    TrajectoryShape viewShapes[NUMBER_OF_AXES];
+    TrajectorySpline viewSplines[NUMBER_OF_AXES];
+
+    // Points of each part without a shape or a spline, and number of steps of the
+    // clock shared by both parts.
+    Array<Point<float>> points[NUMBER_OF_AXES];
+    int numberOfSamples;
+    // Distance from the first point, along the part, as a fraction of its total
+    // length. Only built for the main field part.
+    Array<float> arcLengths[NUMBER_OF_AXES];
+    bool isConstantSpeed;
+    bool isRecordedTiming;
+    bool hasPoints[NUMBER_OF_AXES];
+    TrajectoryShape shapes[NUMBER_OF_AXES];
+    TrajectorySpline splines[NUMBER_OF_AXES];
+    std::atomic<bool> activateStates[NUMBER_OF_AXES];
+
+    bool isBackAndForth;
+    int backAndForthDirection;
+
+    int dampeningCycles;
+    int dampeningCycleCount;
+    double dampeningLastDelta;
+
+    double playbackDuration;
+    int playbackDurationUnit;
+    double currentPlaybackDuration;
+    double trajectoryDeltaTime;
+    double lastTrajectoryDeltaTime;
+
+    float degreeOfDeviationPerCycle;
+    float currentDegreeOfDeviation;
+    int deviationCycleCount;
+
+    // Protects the samples and the playback state against concurrent evaluation from the audio thread.
+    CriticalSection playbackLock;
+
+    // Last positions computed on the audio thread. Both coordinates of an axis are
+    // packed in a single word, so a reader never gets x and y from different blocks.
+    std::atomic<uint64> publishedPositions[NUMBER_OF_AXES];
+    std::atomic<bool> hasPublishedPosition[NUMBER_OF_AXES];
+
+    void resetPlayback();
+    void setCycleFromPpq(double ppqPosition, double quarterNotesPerBar);
+    void computeCurrentSample(Sample& sample);
+    int getNumberOfSteps(int axis) const;
+    void computeArcLengths(int axis);
+    double mapToArcLength(int axis, double phase) const;
+    Point<float> evaluateAxis(int axis, double phase) const;
+    Point<float> getAxisPosition(int axis, double phase) const;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TrajectoryManager)
+};
@@ -0,0 +1,145 @@
+/**************************************************************************
+ * Copyright 2018 UdeM - GRIS - Olivier Belanger                          *
+ *                                                                        *
+ * This file is part of ControlGris, a multi-source spatialization plugin *
+ *                                                                        *
+ * ControlGris is free software: you can redistribute it and/or modify    *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * ControlGris is distributed in the hope that it will be useful,         *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with ControlGris.  If not, see                           *
+ * <http://www.gnu.org/licenses/>.                                        *
+ *************************************************************************/
+#include "TrajectoryShape.h"
+#include "ControlGrisConstants.h"
+#include "ControlGrisMath.h"
+#include "Source.h"
+
+const int TrajectoryShape::kReferenceFieldWidth = MIN_FIELD_WIDTH;
+
+// Margin kept between the trajectory and the border of the field, in pixels.
+static const float kShapeBorder = 8.0f;
+
+// Number of turns of the spirals, and ratio of the last radius to the magnitude.
+static const double kSpiralTurns = 299.0 / 99.0;
+static const double kSpiralRadiusRatio = 299.0 / 300.0;
+
+TrajectoryShape::TrajectoryShape()
+    : drawingType (0), magnitude (0.0f), angle (0.0f) {}
+
+TrajectoryShape::TrajectoryShape(int type, Point<float> startPosition)
+    : drawingType (0), magnitude (0.0f), angle (0.0f)
+{
+    if (type < TRAJECTORY_TYPE_CIRCLE_CLOCKWISE || type > TRAJECTORY_TYPE_TRIANGLE_COUNTER_CLOCKWISE)
+        return;
+
+    const float width = kReferenceFieldWidth;
+    Point<float> translated = startPosition.translated(-0.5f, -0.5f) * 2.0f;
+    drawingType = type;
+    magnitude = sqrtf(translated.x * translated.x + translated.y * translated.y) * ((width - kSourceDiameter) / 2);
+    angle = fastAtan2(translated.y, translated.x) - kMathPi / 2.0f;
+}
+
+bool TrajectoryShape::isValid() const {
+    return drawingType != 0;
+}
+
+int TrajectoryShape::getDrawingType() const {
+    return drawingType;
+}
+
+Point<float> TrajectoryShape::getPosition(double phase) const {
+    const float width = kReferenceFieldWidth;
+    const float center = width / 2.0f;
+    float u = (float)jlimit(0.0, 1.0, phase);
+    float x = center, y = center;
+
+    switch (drawingType) {
+        case TRAJECTORY_TYPE_CIRCLE_CLOCKWISE:
+        case TRAJECTORY_TYPE_CIRCLE_COUNTER_CLOCKWISE: {
+            float theta = 2.0f * kMathPi * u - angle;
+            float s = fastSin(theta);
+            x = (drawingType == TRAJECTORY_TYPE_CIRCLE_CLOCKWISE ? s : -s) * magnitude + center;
+            y = -fastCos(theta) * magnitude + center;
+            break;
+        }
+        case TRAJECTORY_TYPE_ELLIPSE_CLOCKWISE:
+        case TRAJECTORY_TYPE_ELLIPSE_COUNTER_CLOCKWISE:
+        case TRAJECTORY_TYPE_SPIRAL_CLOCKWISE_OUT_IN:
+        case TRAJECTORY_TYPE_SPIRAL_COUNTER_CLOCKWISE_OUT_IN:
+        case TRAJECTORY_TYPE_SPIRAL_CLOCKWISE_IN_OUT:
+        case TRAJECTORY_TYPE_SPIRAL_COUNTER_CLOCKWISE_IN_OUT: {
+            bool isClockwise = drawingType == TRAJECTORY_TYPE_ELLIPSE_CLOCKWISE ||
+                               drawingType == TRAJECTORY_TYPE_SPIRAL_CLOCKWISE_OUT_IN ||
+                               drawingType == TRAJECTORY_TYPE_SPIRAL_CLOCKWISE_IN_OUT;
+            float theta, radiusX, radiusY;
+            if (drawingType == TRAJECTORY_TYPE_ELLIPSE_CLOCKWISE || drawingType == TRAJECTORY_TYPE_ELLIPSE_COUNTER_CLOCKWISE) {
+                theta = 2.0f * kMathPi * u;
+                radiusX = magnitude * 0.5f;
+                radiusY = magnitude;
+            } else {
+                bool isOutIn = drawingType == TRAJECTORY_TYPE_SPIRAL_CLOCKWISE_OUT_IN ||
+                               drawingType == TRAJECTORY_TYPE_SPIRAL_COUNTER_CLOCKWISE_OUT_IN;
+                theta = (float)(2.0 * kMathPi * kSpiralTurns * u);
+                radiusX = radiusY = magnitude * (float)(isOutIn ? 1.0 - u * kSpiralRadiusRatio : u * kSpiralRadiusRatio);
+            }
+            float s = fastSin(theta);
+            float px = (isClockwise ? s : -s) * radiusX;
+            float py = -fastCos(theta) * radiusY;
+            // Rotated by -angle.
+            float c = fastCos(angle), sa = fastSin(angle);
+            x = px * c + py * sa + center;
+            y = py * c - px * sa + center;
+            break;
+        }
+        case TRAJECTORY_TYPE_SQUARE_CLOCKWISE:
+        case TRAJECTORY_TYPE_SQUARE_COUNTER_CLOCKWISE: {
+            float side = jmin(u * 4.0f, 3.9999f);
+            int index = (int)side;
+            float t = side - index;
+            float tmp1, tmp2;
+            switch (index) {
+                case 0: tmp1 = t; tmp2 = 0.0f; break;
+                case 1: tmp1 = 1.0f; tmp2 = t; break;
+                case 2: tmp1 = 1.0f - t; tmp2 = 1.0f; break;
+                default: tmp1 = 0.0f; tmp2 = 1.0f - t; break;
+            }
+            float adjustedMagnitude = magnitude * kMathPi / 2.0f;
+            float px = (drawingType == TRAJECTORY_TYPE_SQUARE_CLOCKWISE ? tmp1 : tmp2) * adjustedMagnitude - adjustedMagnitude / 2;
+            float py = (drawingType == TRAJECTORY_TYPE_SQUARE_CLOCKWISE ? tmp2 : tmp1) * adjustedMagnitude - adjustedMagnitude / 2;
+            float rotation = -angle + kMathPi / 4.0f;
+            float c = fastCos(rotation), s = fastSin(rotation);
+            x = px * c - py * s + center;
+            y = px * s + py * c + center;
+            break;
+        }
+        case TRAJECTORY_TYPE_TRIANGLE_CLOCKWISE:
+        case TRAJECTORY_TYPE_TRIANGLE_COUNTER_CLOCKWISE: {
+            float direction = drawingType == TRAJECTORY_TYPE_TRIANGLE_CLOCKWISE ? 1.0f : -1.0f;
+            const Point<float> corners[4] = { Point<float> (0.0f, -1.0f), Point<float> (direction, 1.0f),
+                                              Point<float> (-direction, 1.0f), Point<float> (0.0f, -1.0f) };
+            float side = jmin(u * 3.0f, 2.9999f);
+            int index = (int)side;
+            float t = side - index;
+            Point<float> p = corners[index] + (corners[index + 1] - corners[index]) * t;
+            float px = p.x * magnitude, py = p.y * magnitude;
+            float c = fastCos(-angle), s = fastSin(-angle);
+            x = px * c - py * s + center;
+            y = px * s + py * c + center;
+            break;
+        }
+        default:
+            break;
+    }
+
+    x = jlimit(kShapeBorder, width - kShapeBorder, x);
+    y = jlimit(kShapeBorder, width - kShapeBorder, y);
+    return Point<float> (x / width, 1.0f - y / width);
+}
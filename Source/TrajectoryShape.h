@@ -0,0 +1,50 @@
+/**************************************************************************
+ * Copyright 2018 UdeM - GRIS - Olivier Belanger                          *
+ *                                                                        *
+ * This file is part of ControlGris, a multi-source spatialization plugin *
+ *                                                                        *
+ * ControlGris is free software: you can redistribute it and/or modify    *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * ControlGris is distributed in the hope that it will be useful,         *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with ControlGris.  If not, see                           *
+ * <http://www.gnu.org/licenses/>.                                        *
+ *************************************************************************/
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+// A generated trajectory (circle, ellipse, spiral, square or triangle), evaluated
+// in closed form for any phase instead of being stored as points.
+//
+// Positions are in normalized source coordinates (0 to 1, y up). The shapes are
+// the ones the field used to sample, for a field of kReferenceFieldWidth pixels,
+// so they do not depend on the size of the editor.
+class TrajectoryShape
+{
+public:
+    TrajectoryShape();
+    // The shape goes through startPosition at phase 0. Types other than the
+    // generated ones give an invalid shape.
+    TrajectoryShape(int drawingType, Point<float> startPosition);
+
+    bool isValid() const;
+    int getDrawingType() const;
+
+    // phase goes from 0 to 1 over a cycle.
+    Point<float> getPosition(double phase) const;
+
+    static const int kReferenceFieldWidth;
+
+private:
+    int drawingType;
+    float magnitude;
+    float angle;
+};
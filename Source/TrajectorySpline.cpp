@@ -0,0 +1,169 @@
+/**************************************************************************
+ * Copyright 2018 UdeM - GRIS - Olivier Belanger                          *
+ *                                                                        *
+ * This file is part of ControlGris, a multi-source spatialization plugin *
+ *                                                                        *
+ * ControlGris is free software: you can redistribute it and/or modify    *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * ControlGris is distributed in the hope that it will be useful,         *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with ControlGris.  If not, see                           *
+ * <http://www.gnu.org/licenses/>.                                        *
+ *************************************************************************/
+#include "TrajectorySpline.h"
+
+static float getDistanceFromSegment(Point<float> p, Point<float> start, Point<float> end) {
+    Point<float> segment = end - start;
+    float lengthSquared = segment.x * segment.x + segment.y * segment.y;
+    if (lengthSquared <= 0.0f) {
+        return p.getDistanceFrom(start);
+    }
+    float t = ((p.x - start.x) * segment.x + (p.y - start.y) * segment.y) / lengthSquared;
+    t = jlimit(0.0f, 1.0f, t);
+    return p.getDistanceFrom(start + segment * t);
+}
+
+TrajectorySpline::TrajectorySpline() : numberOfRecordedPoints (0) {}
+
+void TrajectorySpline::setPoints(const Array<Point<float>>& recordedPoints, const Array<float>& recordedTimes, float tolerance) {
+    clear();
+
+    int size = recordedPoints.size();
+    if (size < 2) {
+        return;
+    }
+    numberOfRecordedPoints = size;
+
+    // Ramer-Douglas-Peucker, with an explicit stack of the ranges left to simplify.
+    Array<bool> keep;
+    keep.insertMultiple(0, false, size);
+    keep.set(0, true);
+    keep.set(size - 1, true);
+
+    Array<Range<int>> ranges;
+    ranges.add(Range<int> (0, size - 1));
+    while (ranges.size() > 0) {
+        Range<int> range = ranges.removeAndReturn(ranges.size() - 1);
+        Point<float> start = recordedPoints.getReference(range.getStart());
+        Point<float> end = recordedPoints.getReference(range.getEnd());
+        float maxDistance = 0.0f;
+        int index = -1;
+        for (int i = range.getStart() + 1; i < range.getEnd(); i++) {
+            float distance = getDistanceFromSegment(recordedPoints.getReference(i), start, end);
+            if (distance > maxDistance) {
+                maxDistance = distance;
+                index = i;
+            }
+        }
+        if (index >= 0 && maxDistance > tolerance) {
+            keep.set(index, true);
+            ranges.add(Range<int> (range.getStart(), index));
+            ranges.add(Range<int> (index, range.getEnd()));
+        }
+    }
+
+    float duration = recordedTimes.size() == size ? recordedTimes.getLast() - recordedTimes.getFirst() : 0.0f;
+    for (int i = 0; i < size; i++) {
+        if (keep[i]) {
+            points.add(recordedPoints.getReference(i));
+            phases.add((float)i / (size - 1));
+            if (duration > 0.0f) {
+                times.add((recordedTimes.getReference(i) - recordedTimes.getFirst()) / duration);
+            }
+        }
+    }
+}
+
+void TrajectorySpline::clear() {
+    points.clear();
+    phases.clear();
+    times.clear();
+    numberOfRecordedPoints = 0;
+}
+
+bool TrajectorySpline::isValid() const {
+    return points.size() > 1;
+}
+
+int TrajectorySpline::getNumberOfPoints() const {
+    return points.size();
+}
+
+Point<float> TrajectorySpline::getPoint(int index) const {
+    return points[index];
+}
+
+float TrajectorySpline::getPhase(int index) const {
+    return phases[index];
+}
+
+void TrajectorySpline::setPointX(int index, float x) {
+    points.getReference(index).setX(x);
+}
+
+int TrajectorySpline::getNumberOfRecordedPoints() const {
+    return numberOfRecordedPoints;
+}
+
+Point<float> TrajectorySpline::getPosition(double phase) const {
+    int size = points.size();
+    if (size == 0) {
+        return Point<float> ();
+    } else if (size == 1) {
+        return points.getFirst();
+    }
+
+    float u = (float)jlimit(0.0, 1.0, phase);
+    int index = (int)(std::upper_bound(phases.begin(), phases.end(), u) - phases.begin()) - 1;
+    index = jlimit(0, size - 2, index);
+
+    float span = phases.getUnchecked(index + 1) - phases.getUnchecked(index);
+    float t = span > 0.0f ? jlimit(0.0f, 1.0f, (u - phases.getUnchecked(index)) / span) : 0.0f;
+
+    const Point<float> p0 = points.getUnchecked(jmax(index - 1, 0));
+    const Point<float> p1 = points.getUnchecked(index);
+    const Point<float> p2 = points.getUnchecked(index + 1);
+    const Point<float> p3 = points.getUnchecked(jmin(index + 2, size - 1));
+
+    float t2 = t * t, t3 = t2 * t;
+    Point<float> position = (p1 * 2.0f + (p2 - p0) * t + (p0 * 2.0f - p1 * 5.0f + p2 * 4.0f - p3) * t2
+                             + (p1 * 3.0f - p0 - p2 * 3.0f + p3) * t3) * 0.5f;
+    return Point<float> (jlimit(0.0f, 1.0f, position.x), jlimit(0.0f, 1.0f, position.y));
+}
+
+bool TrajectorySpline::hasTimes() const {
+    return times.size() > 1;
+}
+
+// The time is interpolated linearly between the knots.
+double TrajectorySpline::getPhaseAtTime(double time) const {
+    int size = times.size();
+    if (size < 2) {
+        return time;
+    }
+
+    float target = (float)time;
+    int index = (int)(std::upper_bound(times.begin(), times.end(), target) - times.begin()) - 1;
+    index = jlimit(0, size - 2, index);
+
+    float span = times.getUnchecked(index + 1) - times.getUnchecked(index);
+    float frac = span > 0.0f ? jlimit(0.0f, 1.0f, (target - times.getUnchecked(index)) / span) : 0.0f;
+    return phases.getUnchecked(index) + (phases.getUnchecked(index + 1) - phases.getUnchecked(index)) * frac;
+}
+
+void TrajectorySpline::getBezierControlPoints(int index, Point<float>& control1, Point<float>& control2) const {
+    int size = points.size();
+    const Point<float> p0 = points[jmax(index - 1, 0)];
+    const Point<float> p1 = points[index];
+    const Point<float> p2 = points[jmin(index + 1, size - 1)];
+    const Point<float> p3 = points[jmin(index + 2, size - 1)];
+    control1 = p1 + (p2 - p0) * (1.0f / 6.0f);
+    control2 = p2 - (p3 - p1) * (1.0f / 6.0f);
+}
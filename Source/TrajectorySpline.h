@@ -0,0 +1,70 @@
+/**************************************************************************
+ * Copyright 2018 UdeM - GRIS - Olivier Belanger                          *
+ *                                                                        *
+ * This file is part of ControlGris, a multi-source spatialization plugin *
+ *                                                                        *
+ * ControlGris is free software: you can redistribute it and/or modify    *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * ControlGris is distributed in the hope that it will be useful,         *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with ControlGris.  If not, see                           *
+ * <http://www.gnu.org/licenses/>.                                        *
+ *************************************************************************/
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+// A drawn trajectory, reduced to the points kept by a Ramer-Douglas-Peucker
+// simplification of the recording and evaluated as a Catmull-Rom spline
+// through them.
+//
+// Only the kept points (the knots) are stored. Each one remembers its index in
+// the recording, as a phase, and the time at which it was recorded, so playback
+// can keep the timing of the recording.
+class TrajectorySpline
+{
+public:
+    TrajectorySpline();
+
+    // points are the recorded positions, at regular intervals, and times the time
+    // at which each one was recorded (can be empty). Points closer than tolerance
+    // to the simplified path are dropped.
+    void setPoints(const Array<Point<float>>& points, const Array<float>& times, float tolerance);
+    void clear();
+
+    bool isValid() const;
+    int getNumberOfPoints() const;
+    Point<float> getPoint(int index) const;
+    float getPhase(int index) const;
+    void setPointX(int index, float x);
+
+    // Number of points of the recording the knots were taken from.
+    int getNumberOfRecordedPoints() const;
+
+    // phase goes from 0 to 1 over the trajectory.
+    Point<float> getPosition(double phase) const;
+
+    // Returns false when the recording had no duration.
+    bool hasTimes() const;
+
+    // Converts a time, from 0 (first point) to 1 (last point), to the phase where
+    // the trajectory was at that time of the recording.
+    double getPhaseAtTime(double time) const;
+
+    // Control points of the cubic Bezier curve equivalent to the segment going
+    // from point index to point index + 1.
+    void getBezierControlPoints(int index, Point<float>& control1, Point<float>& control2) const;
+
+private:
+    Array<Point<float>> points;
+    Array<float> phases;
+    Array<float> times;
+    int numberOfRecordedPoints;
+};
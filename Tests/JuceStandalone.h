@@ -0,0 +1,135 @@
+/**************************************************************************
+ * Copyright 2018 UdeM - GRIS - Olivier Belanger                          *
+ *                                                                        *
+ * This file is part of ControlGris, a multi-source spatialization plugin *
+ *                                                                        *
+ * ControlGris is free software: you can redistribute it and/or modify    *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * ControlGris is distributed in the hope that it will be useful,         *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with ControlGris.  If not, see                           *
+ * <http://www.gnu.org/licenses/>.                                        *
+ *************************************************************************/
+
+#pragma once
+
+// The few JUCE classes and functions used by the source model (SourceBank,
+// Source, SourceFrame) and the /spat/serv encoder, so that the benchmarks in
+// this directory build without JUCE. Include it before any file of Source/:
+// the headers that see CONTROLGRIS_STANDALONE skip JuceHeader.h.
+//
+// Only what these files use is here, with the same behaviour as JUCE.
+
+#define CONTROLGRIS_STANDALONE 1
+#define CONTROLGRIS_MATH_STANDALONE 1
+#if defined (__SSE2__) || defined (_M_X64)
+ #define JUCE_USE_SSE_INTRINSICS 1
+#elif defined (__ARM_NEON)
+ #define JUCE_USE_ARM_NEON 1
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <string>
+
+typedef uint32_t uint32;
+typedef intptr_t pointer_sized_int;
+
+#define jassert(expression) assert(expression)
+
+#define JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(className) \
+    className (const className&) = delete; \
+    className& operator= (const className&) = delete;
+
+template <typename Type>
+inline Type jlimit(Type lowerLimit, Type upperLimit, Type value) {
+    return value < lowerLimit ? lowerLimit : (upperLimit < value ? upperLimit : value);
+}
+
+inline void zeromem(void* memory, size_t numBytes) {
+    memset(memory, 0, numBytes);
+}
+
+template <typename ElementType>
+class HeapBlock
+{
+public:
+    HeapBlock() : data (nullptr) {}
+    ~HeapBlock() { std::free(data); }
+
+    void calloc(size_t numElements) {
+        std::free(data);
+        data = static_cast<ElementType*> (std::calloc(numElements, sizeof(ElementType)));
+    }
+
+    ElementType* get() const { return data; }
+    operator ElementType*() const { return data; }
+
+private:
+    ElementType* data;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (HeapBlock)
+};
+
+struct ByteOrder
+{
+    static uint32 swapIfLittleEndian(uint32 value) {
+       #if defined (__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        return value;
+       #else
+        return (value << 24) | ((value << 8) & 0x00ff0000) | ((value >> 8) & 0x0000ff00) | (value >> 24);
+       #endif
+    }
+};
+
+template <typename ValueType>
+struct Point
+{
+    Point() : x (), y () {}
+    Point(ValueType initialX, ValueType initialY) : x (initialX), y (initialY) {}
+
+    bool operator== (Point other) const { return x == other.x && y == other.y; }
+    bool operator!= (Point other) const { return ! operator== (other); }
+
+    ValueType x, y;
+};
+
+struct Colour
+{
+    Colour() : argb (0xff000000) {}
+    explicit Colour(uint32 colour) : argb (colour) {}
+
+    uint32 argb;
+};
+
+namespace Colours
+{
+    const Colour black (0xff000000);
+}
+
+// Only built, for the constant string lists of ControlGrisConstants.h.
+struct String : std::string
+{
+    String(const char* text) : std::string (text) {}
+};
+
+struct StringArray
+{
+    StringArray(std::initializer_list<String> strings) : size ((int)strings.size()) {}
+
+    int size;
+};
@@ -0,0 +1,331 @@
+/**************************************************************************
+ * Copyright 2018 UdeM - GRIS - Olivier Belanger                          *
+ *                                                                        *
+ * This file is part of ControlGris, a multi-source spatialization plugin *
+ *                                                                        *
+ * ControlGris is free software: you can redistribute it and/or modify    *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * ControlGris is distributed in the hope that it will be useful,         *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with ControlGris.  If not, see                           *
+ * <http://www.gnu.org/licenses/>.                                        *
+ *************************************************************************/
+
+// Batched link solvers of SourceBank against the per-source code they replace,
+// at 8, 64 and 128 sources. The reference below is the scalar math of Source
+// before SourceBank, with the standard library sinf, cosf and atan2f.
+//
+// Build and run with "make -C Tests bench". The program fails if the two
+// disagree by more than the bounds below. The timings are only reported.
+
+#include "JuceStandalone.h"
+
+#include "../Source/SourceBank.cpp"
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+static const int kNumberOfUpdates = 1 << 21;
+
+// Agreement bounds, for x and y (0 to 1) and for the angles (degrees).
+static const float kPositionBound = 1.0e-5f;
+static const float kAngleBound = 1.0e-3f;
+
+static int numberOfFailures = 0;
+
+typedef std::chrono::steady_clock Clock;
+
+// Source::setCoordinatesFromFixedSource, setXYCoordinatesFromFixedSource and
+// setElevationFromFixedSource as they were, with the setters they call.
+struct ReferenceSource
+{
+    bool radiusIsElevation = true;
+    float azimuth = 0.0f, elevation = 0.0f, elevationNoClip = 0.0f, distance = 1.0f, distanceNoClip = 1.0f;
+    float x = 0.0f, y = 0.0f;
+    float fixedAzimuth = -1.0f, fixedElevation = -1.0f, fixedDistance = -1.0f, fixedX = -1.0f, fixedY = -1.0f;
+    bool changed = true;
+
+    static float degreeToRadian(float degree) { return (float)(degree / 360.0 * 2.0 * M_PI); }
+
+    void setAzimuth(float value) {
+        azimuth = value;
+        computeXY();
+    }
+
+    void setElevationNoClip(float value) {
+        elevationNoClip = value;
+        setElevation(elevationNoClip);
+    }
+
+    void setElevation(float value) {
+        if (value < 0.0) {
+            elevation = 0.0;
+        } else if (value > 90.0) {
+            elevation = 90.0;
+        } else {
+            elevationNoClip = elevation = value;
+        }
+        computeXY();
+    }
+
+    void setDistanceNoClip(float value) {
+        distanceNoClip = value;
+        setDistance(distanceNoClip);
+    }
+
+    void setDistance(float value) {
+        if (value < 0.0) {
+            distance = 0.0;
+        } else {
+            distanceNoClip = distance = value;
+        }
+        computeXY();
+    }
+
+    void setCoordinates(float newAzimuth, float newElevation, float newDistance) {
+        azimuth = newAzimuth;
+        elevation = newElevation;
+        distance = newDistance;
+        computeXY();
+        computeAzimuthElevation();
+    }
+
+    void setX(float value) {
+        x = value;
+        computeAzimuthElevation();
+    }
+
+    void setY(float value) {
+        y = value;
+        computeAzimuthElevation();
+    }
+
+    void computeXY() {
+        float radius;
+        if (radiusIsElevation) {
+            radius = (90.0 - elevation) / 90.0;
+        } else {
+            radius = distance;
+        }
+        x = radius * sinf(degreeToRadian(azimuth));
+        x = -x * 0.5 + 0.5;
+        x = x < 0.0 ? 0.0 : x > 1.0 ? 1.0 : x;
+        y = radius * cosf(degreeToRadian(azimuth));
+        y = y * 0.5 + 0.5;
+        y = y < 0.0 ? 0.0 : y > 1.0 ? 1.0 : y;
+        changed = true;
+    }
+
+    void computeAzimuthElevation() {
+        float cx = x * 2.0 - 1.0;
+        float cy = y * 2.0 - 1.0;
+        if (cx != 0.0 || cy != 0.0) {
+            float ang = atan2f(cx, cy) / M_PI * 180.0;
+            if (ang <= -180) {
+                ang += 360.0;
+            }
+            azimuth = -ang;
+        }
+        float rad = sqrtf(cx*cx + cy*cy);
+        if (radiusIsElevation) {
+            rad = rad < 0.0 ? 0.0 : rad > 1.0 ? 1.0 : rad;
+            elevationNoClip = elevation = 90.0 - rad * 90.0;
+        } else {
+            rad = rad < 0.0 ? 0.0 : rad;
+            distanceNoClip = distance = rad;
+        }
+        changed = true;
+    }
+
+    void fixSourcePosition() {
+        fixedAzimuth = azimuth;
+        fixedElevation = elevationNoClip;
+        fixedDistance = distanceNoClip;
+        fixedX = x;
+        fixedY = y;
+    }
+
+    void setCoordinatesFromFixedSource(float deltaAzimuth, float deltaElevation, float deltaDistance) {
+        if (radiusIsElevation) {
+            setAzimuth(fixedAzimuth + deltaAzimuth);
+            setElevationNoClip(fixedElevation + deltaElevation * 90.0f);
+        } else {
+            setAzimuth(fixedAzimuth + deltaAzimuth);
+            setDistanceNoClip(fixedDistance + deltaDistance);
+        }
+        computeXY();
+    }
+
+    void setXYCoordinatesFromFixedSource(float deltaX, float deltaY) {
+        float newX = fixedX + deltaX;
+        float newY = fixedY + deltaY;
+        newX = newX < 0.0f ? 0.0f : newX > 1.0f ? 1.0f : newX;
+        newY = newY < 0.0f ? 0.0f : newY > 1.0f ? 1.0f : newY;
+        setX(newX);
+        setY(newY);
+        computeAzimuthElevation();
+    }
+
+    void setElevationFromFixedSource(float deltaY) {
+        setElevation(fixedElevation + deltaY * 90.0f);
+    }
+};
+
+enum LinkMode
+{
+    kCircular,
+    kCircularDistance,
+    kDeltaLock,
+    kElevation
+};
+
+static const char* const kLinkModeNames[] = { "circular", "circular, distance", "delta lock", "elevation" };
+
+// The delta of the first source at a given step, as the link modes would get it.
+static void getDeltas(int step, float& deltaAzimuth, float& deltaElevation, float& deltaDistance,
+                      float& deltaX, float& deltaY) {
+    float t = (float)(step % 1000) / 1000.0f;
+    deltaAzimuth = 360.0f * t - 180.0f;
+    deltaElevation = 0.4f * t - 0.2f;
+    deltaDistance = 0.5f * t - 0.25f;
+    deltaX = 0.3f * t - 0.15f;
+    deltaY = 0.15f - 0.3f * t;
+}
+
+static void linkReference(std::vector<ReferenceSource>& sources, LinkMode mode, int step) {
+    float deltaAzimuth, deltaElevation, deltaDistance, deltaX, deltaY;
+    getDeltas(step, deltaAzimuth, deltaElevation, deltaDistance, deltaX, deltaY);
+    for (size_t i = 1; i < sources.size(); i++) {
+        switch (mode) {
+            case kCircular:
+            case kCircularDistance:
+                sources[i].setCoordinatesFromFixedSource(deltaAzimuth, deltaElevation, deltaDistance);
+                break;
+            case kDeltaLock:
+                sources[i].setXYCoordinatesFromFixedSource(deltaX, deltaY);
+                break;
+            case kElevation:
+                sources[i].setElevationFromFixedSource(deltaElevation);
+                break;
+        }
+    }
+}
+
+static void linkBank(SourceBank& bank, int numberOfSources, LinkMode mode, int step) {
+    float deltaAzimuth, deltaElevation, deltaDistance, deltaX, deltaY;
+    getDeltas(step, deltaAzimuth, deltaElevation, deltaDistance, deltaX, deltaY);
+    switch (mode) {
+        case kCircular:
+        case kCircularDistance:
+            bank.setCoordinatesFromFixedSources(1, numberOfSources - 1, deltaAzimuth, deltaElevation, deltaDistance);
+            break;
+        case kDeltaLock:
+            bank.setXYCoordinatesFromFixedSources(1, numberOfSources - 1, deltaX, deltaY);
+            break;
+        case kElevation:
+            bank.setElevationsFromFixedSources(1, numberOfSources - 1, deltaElevation);
+            break;
+    }
+}
+
+static float angleDifference(float a, float b) {
+    float difference = std::fmod(std::fabs(a - b), 360.0f);
+    return std::min(difference, 360.0f - difference);
+}
+
+static void compare(const std::vector<ReferenceSource>& sources, const SourceBank& bank,
+                    float& positionError, float& angleError) {
+    for (size_t i = 1; i < sources.size(); i++) {
+        const ReferenceSource& source = sources[i];
+        positionError = std::max(positionError, std::fabs(source.x - bank.x[i]));
+        positionError = std::max(positionError, std::fabs(source.y - bank.y[i]));
+        if (source.radiusIsElevation) {
+            positionError = std::max(positionError, std::fabs(source.elevation - bank.elevation[i]) / 90.0f);
+            angleError = std::max(angleError, std::fabs(source.elevationNoClip - bank.elevationNoClip[i]));
+        } else {
+            positionError = std::max(positionError, std::fabs(source.distanceNoClip - bank.distanceNoClip[i]));
+        }
+        // The azimuth of a source at the centre is arbitrary.
+        if (std::fabs(source.x - 0.5f) > kPositionBound || std::fabs(source.y - 0.5f) > kPositionBound) {
+            angleError = std::max(angleError, angleDifference(source.azimuth, bank.azimuth[i]));
+        }
+    }
+}
+
+static void run(LinkMode mode, int numberOfSources) {
+    bool radiusIsElevation = mode != kCircularDistance;
+    std::vector<ReferenceSource> sources ((size_t)numberOfSources);
+    SourceBank bank (numberOfSources);
+    for (int i = 0; i < numberOfSources; i++) {
+        float azimuth = 360.0f * i / numberOfSources - 180.0f;
+        float elevation = 10.0f + 70.0f * (float)(i % 7) / 7.0f;
+        float distance = 0.2f + 0.8f * (float)(i % 5) / 5.0f;
+
+        ReferenceSource& source = sources[(size_t)i];
+        source.radiusIsElevation = radiusIsElevation;
+        source.setCoordinates(azimuth, elevation, distance);
+        source.fixSourcePosition();
+
+        bank.setRadiusIsElevation(i, radiusIsElevation);
+        bank.x[i] = source.x;
+        bank.y[i] = source.y;
+        bank.azimuth[i] = bank.fixedAzimuth[i] = source.azimuth;
+        bank.elevation[i] = source.elevation;
+        bank.elevationNoClip[i] = bank.fixedElevation[i] = source.elevationNoClip;
+        bank.distance[i] = source.distance;
+        bank.distanceNoClip[i] = bank.fixedDistance[i] = source.distanceNoClip;
+        bank.fixedX[i] = source.x;
+        bank.fixedY[i] = source.y;
+    }
+
+    float positionError = 0.0f, angleError = 0.0f;
+    for (int step = 0; step < 1000; step++) {
+        linkReference(sources, mode, step);
+        linkBank(bank, numberOfSources, mode, step);
+        compare(sources, bank, positionError, angleError);
+    }
+
+    int numberOfSteps = kNumberOfUpdates / (numberOfSources - 1);
+    Clock::time_point start = Clock::now();
+    for (int step = 0; step < numberOfSteps; step++) {
+        linkReference(sources, mode, step);
+    }
+    Clock::time_point middle = Clock::now();
+    for (int step = 0; step < numberOfSteps; step++) {
+        linkBank(bank, numberOfSources, mode, step);
+    }
+    Clock::time_point end = Clock::now();
+
+    double reference = std::chrono::duration<double, std::nano>(middle - start).count() / numberOfSteps;
+    double batched = std::chrono::duration<double, std::nano>(end - middle).count() / numberOfSteps;
+    bool ok = positionError <= kPositionBound && angleError <= kAngleBound;
+    printf("%-19s %3d sources: per source %6.2f us, batched %6.2f us, x%5.1f, max error %.2g / %.2g deg %s\n",
+           kLinkModeNames[mode], numberOfSources, reference * 1e-3, batched * 1e-3, reference / batched,
+           positionError, angleError, ok ? "ok" : "FAILED");
+    if (! ok) {
+        numberOfFailures++;
+    }
+}
+
+int main() {
+    const int sizes[] = { 8, 64, 128 };
+    const LinkMode modes[] = { kCircular, kCircularDistance, kDeltaLock, kElevation };
+    for (LinkMode mode : modes) {
+        for (int size : sizes) {
+            run(mode, size);
+        }
+    }
+    if (numberOfFailures > 0) {
+        printf("%d check(s) failed.\n", numberOfFailures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,160 @@
+/**************************************************************************
+ * Copyright 2018 UdeM - GRIS - Olivier Belanger                          *
+ *                                                                        *
+ * This file is part of ControlGris, a multi-source spatialization plugin *
+ *                                                                        *
+ * ControlGris is free software: you can redistribute it and/or modify    *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * ControlGris is distributed in the hope that it will be useful,         *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with ControlGris.  If not, see                           *
+ * <http://www.gnu.org/licenses/>.                                        *
+ *************************************************************************/
+
+// Accuracy and throughput check of the approximations in ControlGrisMath.h,
+// against the double precision standard library functions.
+//
+// Build and run with "make -C Tests check". The program fails if an error is
+// above the bounds documented in ControlGrisMath.h. The timings are only reported.
+
+#define CONTROLGRIS_MATH_STANDALONE 1
+#if defined (__SSE2__) || defined (_M_X64)
+ #define JUCE_USE_SSE_INTRINSICS 1
+#elif defined (__ARM_NEON)
+ #define JUCE_USE_ARM_NEON 1
+#endif
+
+#include "../Source/ControlGrisMath.h"
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+static const int kNumberOfValues = 1 << 20;
+
+static int numberOfFailures = 0;
+
+static void checkError(const char* name, double maxError, double bound) {
+    bool ok = maxError <= bound;
+    printf("%-28s max error %.3g (bound %.3g) %s\n", name, maxError, bound, ok ? "ok" : "FAILED");
+    if (! ok) {
+        numberOfFailures++;
+    }
+}
+
+// Evaluates f on all the values, a vector at a time.
+template <typename Ops, typename Function>
+static void evaluate(const std::vector<float>& a, const std::vector<float>& b, std::vector<float>& result, Function f) {
+    for (size_t i = 0; i + Ops::size <= a.size(); i += Ops::size) {
+        Ops::store(&result[i], f(Ops::load(&a[i]), Ops::load(&b[i])));
+    }
+}
+
+template <typename Ops>
+static void checkAccuracy(const char* opsName) {
+    char name[64];
+    std::vector<float> x (kNumberOfValues), y (kNumberOfValues), result (kNumberOfValues);
+
+    const double ranges[2] = { 2.0 * M_PI, 8.0 * M_PI };
+    const double sinBounds[2] = { 2.7e-7, 1.3e-6 };
+    for (int r = 0; r < 2; r++) {
+        for (int i = 0; i < kNumberOfValues; i++) {
+            x[i] = (float)(-ranges[r] + 2.0 * ranges[r] * i / (kNumberOfValues - 1));
+        }
+
+        double maxSinError = 0.0, maxCosError = 0.0;
+        evaluate<Ops>(x, x, result, [] (typename Ops::Vector a, typename Ops::Vector) { return polynomialSin<Ops>(a); });
+        for (int i = 0; i < kNumberOfValues; i++) {
+            maxSinError = std::max(maxSinError, std::abs(result[i] - std::sin((double)x[i])));
+        }
+        evaluate<Ops>(x, x, result, [] (typename Ops::Vector a, typename Ops::Vector) { return Ops::cos(a); });
+        for (int i = 0; i < kNumberOfValues; i++) {
+            maxCosError = std::max(maxCosError, std::abs(result[i] - std::cos((double)x[i])));
+        }
+
+        snprintf(name, sizeof (name), "%s sin, |x| <= %d pi", opsName, r == 0 ? 2 : 8);
+        checkError(name, maxSinError, sinBounds[r]);
+        snprintf(name, sizeof (name), "%s cos, |x| <= %d pi", opsName, r == 0 ? 2 : 8);
+        checkError(name, maxCosError, sinBounds[r]);
+    }
+
+    // Points on circles of different radii, all around the origin.
+    for (int i = 0; i < kNumberOfValues; i++) {
+        double angle = 2.0 * M_PI * i / kNumberOfValues;
+        double radius = std::pow(10.0, (i % 7) - 3.0);
+        y[i] = (float)(radius * std::sin(angle));
+        x[i] = (float)(radius * std::cos(angle));
+    }
+    double maxAtan2Error = 0.0;
+    evaluate<Ops>(y, x, result, [] (typename Ops::Vector a, typename Ops::Vector b) { return polynomialAtan2<Ops>(a, b); });
+    for (int i = 0; i < kNumberOfValues; i++) {
+        double error = std::abs(result[i] - std::atan2((double)y[i], (double)x[i]));
+        // -pi and pi are the same angle.
+        maxAtan2Error = std::max(maxAtan2Error, std::min(error, std::abs(error - 2.0 * M_PI)));
+    }
+    snprintf(name, sizeof (name), "%s atan2", opsName);
+    checkError(name, maxAtan2Error, 2.8e-7);
+}
+
+template <typename Function>
+static double measureNanoseconds(const std::vector<float>& x, std::vector<float>& result, int step, Function f) {
+    auto start = std::chrono::steady_clock::now();
+    for (int repeat = 0; repeat < 10; repeat++) {
+        for (size_t i = 0; i + step <= x.size(); i += step) {
+            f(&x[i], &result[i]);
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano> (end - start).count() / (10.0 * x.size());
+}
+
+static void measureThroughput() {
+    std::vector<float> x (kNumberOfValues), result (kNumberOfValues);
+    for (int i = 0; i < kNumberOfValues; i++) {
+        x[i] = (float)(-M_PI + 2.0 * M_PI * i / kNumberOfValues);
+    }
+
+    double sinf_ = measureNanoseconds(x, result, 1, [] (const float* a, float* r) { *r = sinf(*a); });
+    double fastSin_ = measureNanoseconds(x, result, 1, [] (const float* a, float* r) { *r = fastSin(*a); });
+    double atan2f_ = measureNanoseconds(x, result, 1, [] (const float* a, float* r) { *r = atan2f(*a, 0.5f); });
+    double fastAtan2_ = measureNanoseconds(x, result, 1, [] (const float* a, float* r) { *r = fastAtan2(*a, 0.5f); });
+    printf("sinf %.2f ns, fastSin %.2f ns, atan2f %.2f ns, fastAtan2 %.2f ns per value\n", sinf_, fastSin_, atan2f_, fastAtan2_);
+
+#if CONTROLGRIS_MATH_HAS_VECTOR_OPS
+    double vectorSin = measureNanoseconds(x, result, VectorMathOps::size, [] (const float* a, float* r) {
+        VectorMathOps::store(r, VectorMathOps::sin(VectorMathOps::load(a)));
+    });
+    double vectorAtan2 = measureNanoseconds(x, result, VectorMathOps::size, [] (const float* a, float* r) {
+        VectorMathOps::store(r, VectorMathOps::atan2(VectorMathOps::load(a), VectorMathOps::set(0.5f)));
+    });
+    printf("vector sin %.2f ns, vector atan2 %.2f ns per value\n", vectorSin, vectorAtan2);
+#endif
+
+    // Keeps the results alive.
+    float sum = 0.0f;
+    for (float r : result) {
+        sum += r;
+    }
+    printf("(checksum %g)\n", sum);
+}
+
+int main() {
+    checkAccuracy<ScalarMathOps>("scalar");
+#if CONTROLGRIS_MATH_HAS_VECTOR_OPS
+    checkAccuracy<VectorMathOps>("vector");
+#endif
+    measureThroughput();
+
+    if (numberOfFailures > 0) {
+        printf("%d check(s) failed.\n", numberOfFailures);
+        return 1;
+    }
+    return 0;
+}
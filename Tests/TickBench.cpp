@@ -0,0 +1,150 @@
+/**************************************************************************
+ * Copyright 2018 UdeM - GRIS - Olivier Belanger                          *
+ *                                                                        *
+ * This file is part of ControlGris, a multi-source spatialization plugin *
+ *                                                                        *
+ * ControlGris is free software: you can redistribute it and/or modify    *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * ControlGris is distributed in the hope that it will be useful,         *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with ControlGris.  If not, see                           *
+ * <http://www.gnu.org/licenses/>.                                        *
+ *************************************************************************/
+
+// Cost of one tick of the message thread timer with 128 linked sources: the
+// link solver, the publication of the source snapshot and the encoding of the
+// /spat/serv messages, as done by timerCallback, sendOscMessage and the OSC
+// sender thread. Sending the datagrams is left out.
+//
+// Build and run with "make -C Tests bench". The timings are only reported.
+
+#include "JuceStandalone.h"
+
+#include "../Source/SourceBank.cpp"
+#include "../Source/Source.cpp"
+#include "../Source/SourceFrame.cpp"
+#include "../Source/SpatServEncoder.cpp"
+
+#include <chrono>
+#include <cstdio>
+
+static const int kNumberOfSources = MAX_NUMBER_OF_SOURCES;
+static const int kNumberOfTicks = 20000;
+
+typedef std::chrono::steady_clock Clock;
+
+static double elapsedNanoseconds(Clock::time_point start, Clock::time_point end) {
+    return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+}
+
+struct TickTimes
+{
+    double link = 0.0, publish = 0.0, encode = 0.0;
+};
+
+// Same conversions as ControlGrisAudioProcessor::sendOscMessage, for the sources
+// whose version has changed, then the encoding of OscSenderThread::run.
+static int encodeChangedSources(const SourceFrame* frames, int numberOfSources, uint32* lastVersions,
+                                SpatServEncoder& encoder, bool useBundles, int maxNumBundleMessages) {
+    int numBundleMessages = 0, numBytes = 0;
+    SpatServFrame frame;
+    for (int i = 0; i < numberOfSources; i++) {
+        const SourceFrame& source = frames[i];
+        if (source.version == lastVersions[i]) {
+            continue;
+        }
+        lastVersions[i] = source.version;
+
+        frame.sourceId = source.id;
+        frame.azimuth = -source.azimuth / 180.0 * M_PI;
+        frame.elevation = (M_PI / 2.0) - (source.elevation / 360.0 * M_PI * 2.0);
+        frame.azimuthSpan = source.azimuthSpan * 2.0;
+        frame.elevationSpan = source.elevationSpan * 0.5;
+        frame.distance = source.distance;
+
+        if (useBundles) {
+            if (numBundleMessages == maxNumBundleMessages) {
+                numBytes += SpatServEncoder::getBundleSize(numBundleMessages) + encoder.getBundleData()[0];
+                numBundleMessages = 0;
+            }
+            encoder.setBundleMessage(numBundleMessages++, frame);
+        } else {
+            numBytes += SpatServEncoder::kMessageSize + encoder.encodeMessage(frame)[0];
+        }
+    }
+    if (numBundleMessages > 0) {
+        numBytes += SpatServEncoder::getBundleSize(numBundleMessages) + encoder.getBundleData()[0];
+    }
+    return numBytes;
+}
+
+static void runTicks(const char* name, bool isDeltaLock, bool useBundles) {
+    SourceBank bank (kNumberOfSources);
+    std::unique_ptr<Source[]> sources (new Source[kNumberOfSources]);
+    for (int i = 0; i < kNumberOfSources; i++) {
+        sources[i].setBank(&bank, i);
+        sources[i].setId(i);
+        sources[i].setCoordinates(360.0f * i / kNumberOfSources - 180.0f, 30.0f, 1.0f);
+        sources[i].fixSourcePosition(true);
+    }
+
+    SourceFrameBuffer frameBuffer;
+    std::unique_ptr<SourceFrame[]> frames (new SourceFrame[MAX_NUMBER_OF_SOURCES]);
+    std::unique_ptr<uint32[]> lastVersions (new uint32[MAX_NUMBER_OF_SOURCES]());
+    SpatServEncoder encoder;
+    int maxNumBundleMessages = encoder.getMaxNumBundleMessages(DEFAULT_OSC_MAX_DATAGRAM_SIZE);
+
+    TickTimes times;
+    long long numBytes = 0;
+    for (int tick = 0; tick < kNumberOfTicks; tick++) {
+        // The first source follows a circle, as with a generated trajectory.
+        float angle = 2.0f * (float)M_PI * tick / 500.0f;
+        Point<float> position (0.5f + 0.3f * std::sin(angle), 0.5f + 0.3f * std::cos(angle));
+
+        Clock::time_point start = Clock::now();
+        if (isDeltaLock) {
+            sources[0].setPos(position);
+            bank.setXYCoordinatesFromFixedSources(1, kNumberOfSources - 1, sources[0].getDeltaX(), sources[0].getDeltaY());
+        } else {
+            sources[0].setPos(position);
+            bank.setCoordinatesFromFixedSources(1, kNumberOfSources - 1, sources[0].getDeltaAzimuth(),
+                                                sources[0].getDeltaElevation(), 0.0f);
+        }
+        Clock::time_point linked = Clock::now();
+        frameBuffer.publish(sources.get(), kNumberOfSources);
+        Clock::time_point published = Clock::now();
+        int numberOfSources = frameBuffer.read(frames.get());
+        numBytes += encodeChangedSources(frames.get(), numberOfSources, lastVersions.get(), encoder,
+                                         useBundles, maxNumBundleMessages);
+        Clock::time_point encoded = Clock::now();
+
+        times.link += elapsedNanoseconds(start, linked);
+        times.publish += elapsedNanoseconds(linked, published);
+        times.encode += elapsedNanoseconds(published, encoded);
+    }
+
+    double total = (times.link + times.publish + times.encode) / kNumberOfTicks;
+    printf("%-28s link %6.2f us, publish %6.2f us, encode %6.2f us, total %6.2f us per tick (%.2f %% of a %d Hz tick)\n",
+           name, times.link / kNumberOfTicks * 1e-3, times.publish / kNumberOfTicks * 1e-3,
+           times.encode / kNumberOfTicks * 1e-3, total * 1e-3, total * 1e-9 * DEFAULT_OSC_OUTPUT_RATE * 100.0,
+           DEFAULT_OSC_OUTPUT_RATE);
+    if (numBytes == 0) {
+        printf("  no message was encoded\n");
+    }
+}
+
+int main() {
+    printf("%d sources, %d ticks\n", kNumberOfSources, kNumberOfTicks);
+    runTicks("circular, bundles", false, true);
+    runTicks("circular, single messages", false, false);
+    runTicks("delta lock, bundles", true, true);
+    runTicks("delta lock, single messages", true, false);
+    return 0;
+}
@@ -0,0 +1,122 @@
+/**************************************************************************
+ * Copyright 2018 UdeM - GRIS - Olivier Belanger                          *
+ *                                                                        *
+ * This file is part of ControlGris, a multi-source spatialization plugin *
+ *                                                                        *
+ * ControlGris is free software: you can redistribute it and/or modify    *
+ * it under the terms of the GNU Lesser General Public License as         *
+ * published by the Free Software Foundation, either version 3 of the     *
+ * License, or (at your option) any later version.                        *
+ *                                                                        *
+ * ControlGris is distributed in the hope that it will be useful,         *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU Lesser General Public License for more details.                    *
+ *                                                                        *
+ * You should have received a copy of the GNU Lesser General Public       *
+ * License along with ControlGris.  If not, see                           *
+ * <http://www.gnu.org/licenses/>.                                        *
+ *************************************************************************/
+
+// Number of sin, cos and atan2 evaluations in one tick of the message thread
+// timer with 128 linked sources, and in the lazy getters of Source. Each
+// source has to be converted once per tick, with one evaluation of each
+// function it needs: the program fails if any step does more.
+//
+// Build and run with "make -C Tests bench".
+
+static long long numberOfTrigValues = 0;
+#define CONTROLGRIS_MATH_COUNT(numberOfValues) (numberOfTrigValues += (numberOfValues))
+
+#include "JuceStandalone.h"
+
+#include "../Source/SourceBank.cpp"
+#include "../Source/Source.cpp"
+#include "../Source/SourceFrame.cpp"
+
+#include <cstdio>
+
+static const int kNumberOfSources = MAX_NUMBER_OF_SOURCES;
+
+static int numberOfFailures = 0;
+
+static void checkCount(const char* name, long long count, long long expected) {
+    bool ok = count <= expected;
+    printf("%-40s %5lld (at most %lld) %s\n", name, count, expected, ok ? "ok" : "FAILED");
+    if (! ok) {
+        numberOfFailures++;
+    }
+}
+
+static void resetSources(SourceBank& bank, Source* sources, bool radiusIsElevation) {
+    for (int i = 0; i < kNumberOfSources; i++) {
+        sources[i].setBank(&bank, i);
+        sources[i].setRadiusIsElevation(radiusIsElevation);
+        sources[i].setCoordinates(360.0f * i / kNumberOfSources - 180.0f, 30.0f, 0.8f);
+        sources[i].fixSourcePosition(true);
+        sources[i].fixSourcePositionElevation(true);
+    }
+}
+
+int main() {
+    SourceBank bank (kNumberOfSources);
+    std::unique_ptr<Source[]> sources (new Source[kNumberOfSources]);
+    SourceFrameBuffer frameBuffer;
+    const int numberOfLinked = kNumberOfSources - 1;
+
+    printf("%d sources, sin, cos and atan2 values per step\n", kNumberOfSources);
+
+    // Circular link: source 0 is moved, its polar coordinates give the delta.
+    resetSources(bank, sources.get(), true);
+    frameBuffer.publish(sources.get(), kNumberOfSources);
+    numberOfTrigValues = 0;
+    sources[0].setPos(Point<float> (0.7f, 0.4f));
+    bank.setCoordinatesFromFixedSources(1, numberOfLinked, sources[0].getDeltaAzimuth(), sources[0].getDeltaElevation(), 0.0f);
+    checkCount("circular link", numberOfTrigValues, 1 + 2 * numberOfLinked);
+    numberOfTrigValues = 0;
+    frameBuffer.publish(sources.get(), kNumberOfSources);
+    checkCount("publish after the link", numberOfTrigValues, 0);
+
+    // Delta lock: the cartesian delta moves the other sources.
+    numberOfTrigValues = 0;
+    sources[0].setPos(Point<float> (0.6f, 0.3f));
+    bank.setXYCoordinatesFromFixedSources(1, numberOfLinked, sources[0].getDeltaX(), sources[0].getDeltaY());
+    frameBuffer.publish(sources.get(), kNumberOfSources);
+    checkCount("delta lock and publish", numberOfTrigValues, 1 + numberOfLinked);
+
+    // Elevation link of the LBAP mode.
+    resetSources(bank, sources.get(), false);
+    numberOfTrigValues = 0;
+    sources[0].setNormalizedElevation(0.5f);
+    bank.setElevationsFromFixedSources(1, numberOfLinked, sources[0].getDeltaElevation());
+    frameBuffer.publish(sources.get(), kNumberOfSources);
+    checkCount("elevation link and publish", numberOfTrigValues, 2 * kNumberOfSources);
+
+    // The editor reads all the coordinates of all the sources on every repaint.
+    numberOfTrigValues = 0;
+    float sum = 0.0f;
+    for (int i = 0; i < kNumberOfSources; i++) {
+        sum += sources[i].getX() + sources[i].getY() + sources[i].getAzimuth() + sources[i].getElevation() + sources[i].getDistance();
+    }
+    checkCount("getters of all sources, up to date", numberOfTrigValues, 0);
+
+    // Several setters before a read convert only once.
+    numberOfTrigValues = 0;
+    sources[1].setX(0.2f);
+    sources[1].setY(0.3f);
+    sum += sources[1].getAzimuth() + sources[1].getDistance() + sources[1].getAzimuth();
+    checkCount("setX, setY, then three polar getters", numberOfTrigValues, 1);
+
+    numberOfTrigValues = 0;
+    sources[1].setAzimuth(45.0f);
+    sources[1].setDistance(0.5f);
+    sum += sources[1].getX() + sources[1].getY() + sources[1].getX();
+    checkCount("setAzimuth, setDistance, then getX, getY", numberOfTrigValues, 2);
+
+    printf("(checksum %g)\n", sum);
+    if (numberOfFailures > 0) {
+        printf("%d check(s) failed.\n", numberOfFailures);
+        return 1;
+    }
+    return 0;
+}